@@ -87,15 +87,25 @@
 #define SBOARRAY_H
 
 // @todo:: see what kind of support can be ported in
-#if __cplusplus == 202002L
+//     ranges, compilers report in progress standards with in between values (gcc 12 -std=c++23 is 202100L)
+//     msvc only reports the real value in _MSVC_LANG unless /Zc:__cplusplus is on
+#if defined(_MSVC_LANG) && _MSVC_LANG > __cplusplus
+    #define SBOARRAY_CPLUSPLUS _MSVC_LANG
+#else
+    #define SBOARRAY_CPLUSPLUS __cplusplus
+#endif
+
+#if SBOARRAY_CPLUSPLUS > 202002L
+    #define CPP_STANDARD 2023
+#elif SBOARRAY_CPLUSPLUS >= 202002L
     #define CPP_STANDARD 2020
-#elif __cplusplus == 201703L
+#elif SBOARRAY_CPLUSPLUS >= 201703L
     #define CPP_STANDARD 2017
-#elif __cplusplus == 201402L
+#elif SBOARRAY_CPLUSPLUS >= 201402L
     #define CPP_STANDARD 2014
-#elif __cplusplus == 201103L
+#elif SBOARRAY_CPLUSPLUS >= 201103L
     #define CPP_STANDARD 2011
-#elif __cplusplus == 199711L
+#elif SBOARRAY_CPLUSPLUS >= 199711L
     #define CPP_STANDARD 1998
 #else
     #define CPP_STANDARD 1989
@@ -109,15 +119,190 @@
 #endif
 
 #include <initializer_list> // for EmplaceBack
+#include <algorithm>        // sort, move_backward
+#include <functional>       // less
 #include <type_traits>      // trivially_...
 #include <new>              // std::launder, c++17 removes some UB when using char buffers for object storage
-#include <stdexcept>        // to provide exception safety for .at(index)
+#include <atomic>           // SboArena borrowers, SboArrayStats
 #include <cassert>          // assert
+#include <cstddef>          // max_align_t
+#include <cstdint>          // uint8_t
+#include <cstdlib>          // malloc, free, abort
 #include <cstring>          // memcpy, memmove
+#include <iterator>         // reverse_iterator, distance
+#include <memory>           // addressof
+
+#if CPP_STANDARD > 2017
+    #include <ranges>       // contiguous_range, sized_range
+    #include <span>         // span
+#endif
+
+// -fno-exceptions builds are detected from the compiler, define SBOARRAY_NO_EXCEPTIONS to force it
+//     without exceptions nothing throws, out of memory and .at() out of range abort instead
+//     the try_ calls never throw or abort in either mode, they report a SboArrayStatus and leave the array as it was
+#if !defined(SBOARRAY_NO_EXCEPTIONS) && !(defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND))
+    #define SBOARRAY_NO_EXCEPTIONS
+#endif
+
+#ifndef SBOARRAY_NO_EXCEPTIONS
+#include <stdexcept>        // to provide exception safety for .at(index)
+#endif
+
+enum class SboArrayStatus : uint8_t
+{
+    Ok,
+    OutOfMemory,
+    OutOfRange,
+};
+
+// define SBOARRAY_TRACK_ALLOCATIONS to count heap traffic across every SboArray instantiation
+//     used by the benchmarks to report allocations/spills per operation, compiles away otherwise
+#ifdef SBOARRAY_TRACK_ALLOCATIONS
+struct SboArrayStats
+{
+    static inline std::atomic<size_t> allocations{0};   // every Malloc
+    static inline std::atomic<size_t> frees{0};         // every Free of a non-null pointer
+    static inline std::atomic<size_t> spills{0};        // transitions from stack_buffer to heap
+    static inline std::atomic<size_t> bytes{0};         // total bytes requested from Malloc
+
+    static void Reset() { allocations = 0; frees = 0; spills = 0; bytes = 0; }
+};
+
+    #define SBOARRAY_STAT(stat, n) (SboArrayStats::stat.fetch_add((n), std::memory_order_relaxed))
+#else
+    #define SBOARRAY_STAT(stat, n) ((void)0)
+#endif
+
+// define SBOARRAY_LARGE_COPY to send bulk copies of at least SboLargeCopy::threshold bytes (growth of pod/relocatable
+//     elements, copy construction and append_range of pod) through non temporal stores, split over
+//     SboLargeCopy::threads threads, a 100MB reallocation then runs at memory bandwidth and does not flush the
+//     last level cache on the way, compiles away otherwise
+#ifdef SBOARRAY_LARGE_COPY
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define SBOARRAY_STREAM_SSE 1
+#else
+    #define SBOARRAY_STREAM_SSE 0
+#endif
+
+struct SboLargeCopy
+{
+    static inline size_t threshold = size_t(32) << 20;  // well past a typical L3, below it memcpy wins
+    static inline unsigned threads = 1;                 // threads per copy, the calling thread is one of them
+    static constexpr size_t max_workers = 64;           // threads past 1 + max_workers are ignored
+
+    // dest and src must not overlap
+    static void Copy(void* dest, const void* src, size_t bytes) noexcept
+    {
+        char* d = static_cast<char*>(dest);
+        const char* s = static_cast<const char*>(src);
+        const size_t chunks = std::min<size_t>((threads > 1) ? threads : 1, max_workers + 1);
+        if (chunks == 1) { Stream(d, s, bytes); return; }
+
+        // 4KB aligned slices, so no two threads ever write the same page, rounding up means there are at most chunks
+        const size_t step = ((bytes + chunks - 1) / chunks + 4095) & ~size_t(4095);
+        std::thread workers[max_workers];
+        size_t spawned = 0;
+        for (size_t offset = step; offset < bytes; offset += step)
+        {
+            assert(spawned < max_workers);
+            const size_t n = (bytes - offset < step) ? bytes - offset : step;
+            if (Spawn(workers[spawned], d + offset, s + offset, n)) { ++spawned; }
+            else { Stream(d + offset, s + offset, n); }
+        }
+        Stream(d, s, (bytes < step) ? bytes : step);
+        for (size_t i = 0; i < spawned; ++i) { workers[i].join(); }
+    }
+
+    // false when the thread could not be started (std::system_error), the caller streams that slice itself
+    //     without exceptions the standard library aborts on that instead, nothing to catch
+    static bool Spawn(std::thread& worker, char* d, const char* s, size_t bytes) noexcept
+    {
+    #ifndef SBOARRAY_NO_EXCEPTIONS
+        try { worker = std::thread(Stream, d, s, bytes); }
+        catch (...) { return false; }
+    #else
+        worker = std::thread(Stream, d, s, bytes);
+    #endif
+        return true;
+    }
+
+    static void Stream(char* d, const char* s, size_t bytes) noexcept
+    {
+    #if SBOARRAY_STREAM_SSE
+        // memcpy up to a 64 byte aligned destination, stream whole cache lines, memcpy the tail
+        const size_t head = (64 - (reinterpret_cast<uintptr_t>(d) & 63)) & 63;
+        if (bytes < head + 64) { std::memcpy(d, s, bytes); return; }
+        std::memcpy(d, s, head);
+        d += head; s += head; bytes -= head;
+
+        for (; bytes >= 64; d += 64, s += 64, bytes -= 64)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+            const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d), a);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), b);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), c);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), e);
+        }
+        _mm_sfence();   // streaming stores are weakly ordered, make them visible before anyone reads the block
+        std::memcpy(d, s, bytes);
+    #else
+        std::memcpy(d, s, bytes);
+    #endif
+    }
+};
+#endif
+
+// opt in, specialize to true_type for types that can be moved with a memcpy and the source forgotten (nothing
+//     points into the object, it is not registered by address anywhere), growth, insert and erase then shift
+//     them in bulk instead of one move + destroy at a time
+//     std::unique_ptr and most handle types are, libstdc++'s std::string is not (it points into itself)
+template <typename T>
+struct SboRelocatable : std::is_trivially_copyable<T> {};
+
+// read prefetch into every cache level, a hint only, the other sbo headers (sbo_search_index.h) use it too
+#if defined(__GNUC__) || defined(__clang__)
+    #define SBOARRAY_PREFETCH(address) __builtin_prefetch(address)
+#elif defined(_M_X64) || defined(_M_IX86)
+    #include <xmmintrin.h>
+    #define SBOARRAY_PREFETCH(address) _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#else
+    #define SBOARRAY_PREFETCH(address) ((void)0)
+#endif
+
+// sbo_heap_compactor.h, the only thing allowed to put an array's heap buffer somewhere it does not own
+class SboHeapCompactor;
+
+// the header at the front of an SboHeapCompactor arena, every slice in it is preceded by a pointer back here
+//     so an array can let go of its slice by itself, the arena is freed once the compactor and every array
+//     borrowing a slice (registered or not, a moved to array takes the slice with it) have let go
+struct SboArena
+{
+    static constexpr size_t align = alignof(std::max_align_t);  // header and slice prefix size, slices start aligned
+
+    std::atomic<size_t> borrowers;  // the compactor counts as one while it holds the arena
+
+    static SboArena* Of(const void* slice) noexcept     { return *reinterpret_cast<SboArena* const*>(static_cast<const char*>(slice) - align); }
+    static void Release(const void* slice) noexcept     { Of(slice)->Drop(); }
+    void Drop() noexcept
+    {
+        if (borrowers.fetch_sub(1, std::memory_order_acq_rel) != 1) { return; }
+        this->~SboArena();
+        ::operator delete(this);
+    }
+};
+static_assert(sizeof(SboArena) <= SboArena::align && sizeof(SboArena*) <= SboArena::align, "SboArena header must fit its slot");
 
 template <typename T, size_t size_threshold = 64>
 class SboArray
 {
+    friend class SboHeapCompactor;
+    template <typename, size_t> friend class SboArray;
 
 //=====================================================================================================================
 // Public Api
@@ -129,26 +314,75 @@ public:
     SboArray(size_t size)                               { ContainerConstructor_Size(size); }
     SboArray(size_t size, const T& value)               { ContainerConstructor_SizeValue(size, value); }
     SboArray(const SboArray& rhs)                       { ContainerConstructor_Copy(rhs); }
-    SboArray(SboArray&& rhs)                            { ContainerConstructor_Move(std::move(rhs)); }
+    SboArray(SboArray&& rhs) noexcept                   { ContainerConstructor_Move(std::move(rhs)); }
     SboArray(std::initializer_list<T> init)             { ContainerConstructor_List(init); }
     SboArray& operator=(const SboArray& rhs)            { return ContainerAssignment_Copy(rhs); }
-    SboArray& operator=(SboArray&& rhs) noexcept        { return ContainerAssignment_Move(rhs); }
+    SboArray& operator=(SboArray&& rhs) noexcept        { return ContainerAssignment_Move(std::move(rhs)); }
+
+    // from a different threshold, the heap buffer is taken when it is bigger than our stack buffer, otherwise the
+    //     elements are moved (memcpy for pod) into the stack buffer or one fresh block
+    template <size_t other_threshold>
+    SboArray(SboArray<T, other_threshold>&& rhs)        { ContainerConstructor(); ConvertFrom(rhs); }
+    template <size_t other_threshold>
+    SboArray& operator=(SboArray<T, other_threshold>&& rhs) { return ContainerAssignment_Convert(rhs); }
     ~SboArray()                                         { ContainerDestructor(); }
     
     // push/pop/grow/shrink
     template <typename... Args> 
-    void emplace_back(Args&&... args)                   { EmplaceBack(std::forward<Args>(args)...); }
+    T& emplace_back(Args&&... args)                     { return EmplaceBack(std::forward<Args>(args)...); }
+
+    // init(T* slot) builds the element straight into the raw slot (placement new, or plain writes for pod),
+    //     if init throws the slot stays raw and the size is unchanged
+    template <typename F>
+    T& emplace_back_with(F&& init)                      { return EmplaceBackWith(init); }
     void reserve(size_t new_cap)                        { Reserve(new_cap); }
     void shrink_to_fit()                                { ShrinkToFit(); }
     void push_back(const T& value)                      { PushBack_Copy(value); }
-    void push_back(T&& value) noexcept                  { PushBack_Move(std::move(value)); }
+    void push_back(T&& value)                           { PushBack_Move(std::move(value)); }
     void pop_back() noexcept                            { PopBack(); }
-    void clear() noexcept                               { CallDestructors(); count_ = 0; }
+    void clear() noexcept                               { Clear(); }
+
+    // opt in, off by default, after `cycles` clear()/pop_back() calls in a row that leave the heap buffer under
+    //     `percent` full, it is shrunk to twice what was in use, or moved back into the stack buffer when that fits
+    //     any call at or above `percent` starts the count over, so an array that only dips for a frame keeps its memory
+    //     a trim from pop_back() reallocates, pointers into the array are invalidated like after any growth
+    //     the setting belongs to this array, copies, moves, swaps and assignments never carry it to another one
+    void set_auto_trim(uint8_t cycles, uint8_t percent = 25) noexcept { trim_cycles_ = cycles; trim_percent_ = percent; low_cycles_ = 0; }
+    
+    // pod only, grows capacity to n then lets op write straight into [data(), data() + n)
+    //     op(T* data, size_t n) returns the new size (<= n), like std::string::resize_and_overwrite
+    template <typename Op>
+    void resize_and_overwrite(size_t n, Op op)          { ResizeAndOverwrite(n, op); }
+
+    // first touch, grows to n in three steps so the pages of [size(), n) are first written by the threads that
+    //     will work on them later (numa), begin, then every slice of [0, n) from its own thread, then end
+    //     slice i of k is [n * i / k, n * (i + 1) / k), init(T* slot, size_t index) constructs into the raw slot
+    //     and must not throw, see sbo_first_touch.h for handing the slices to a worker pool
+    void begin_first_touch(size_t n)                    { Reserve(n); }
+    template <typename Init>
+    void init_slice(size_t n, size_t slice, size_t slices, Init&& init) { InitSlice(n, slice, slices, init); }
+    void end_first_touch(size_t n) noexcept             { assert(n >= count_ && n <= capacity_); count_ = n; }
+
+    // new elements are value initialized (or copies of value), shrinking destroys the tail
+    void resize(size_t n)                               { if (!TryResizeCount(n)) { OutOfMemory(); } }
+    void resize(size_t n, const T& value)               { if (!TryResizeCount(n, value)) { OutOfMemory(); } }
+
+    // fallible, no exceptions and no abort, on failure the array is unchanged
+    [[nodiscard]] SboArrayStatus try_reserve(size_t new_cap) noexcept { return TryReserve(new_cap) ? SboArrayStatus::Ok : SboArrayStatus::OutOfMemory; }
+    [[nodiscard]] SboArrayStatus try_push_back(const T& value)        { return TryEmplaceBack(value); }
+    [[nodiscard]] SboArrayStatus try_push_back(T&& value)             { return TryEmplaceBack(std::move(value)); }
+    template <typename... Args>
+    [[nodiscard]] SboArrayStatus try_emplace_back(Args&&... args)     { return TryEmplaceBack(std::forward<Args>(args)...); }
+    [[nodiscard]] SboArrayStatus try_resize(size_t n)                 { return TryResizeCount(n) ? SboArrayStatus::Ok : SboArrayStatus::OutOfMemory; }
+    [[nodiscard]] SboArrayStatus try_resize(size_t n, const T& value) { return TryResizeCount(n, value) ? SboArrayStatus::Ok : SboArrayStatus::OutOfMemory; }
+    T* try_at(size_t i) noexcept                        { return (i < count_) ? data_ptr() + i : nullptr; }
+    const T* try_at(size_t i) const noexcept            { return (i < count_) ? data_ptr() + i : nullptr; }
 
     // query
     bool empty() const noexcept                         { return count_ == 0; }
     size_t size() const noexcept                        { return count_; }
     size_t capacity() const noexcept                    { return capacity_; }
+    static constexpr size_t inline_capacity = size_threshold;
     inline bool using_stack_buffer() const noexcept     { return !using_heap_; }
     
     // accessors
@@ -168,8 +402,14 @@ public:
 
     // iterators
     using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using const_pointer = const T*;
     using iterator = T*;
     using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
     using reference = T&;
     using const_reference = const T&;
     
@@ -177,10 +417,16 @@ public:
     iterator end() noexcept                             { return data_ptr() + count_; }
     const_iterator begin() const noexcept               { return data_ptr(); }
     const_iterator end() const noexcept                 { return data_ptr() + count_; }
+    reverse_iterator rbegin() noexcept                  { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept                    { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept      { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept        { return const_reverse_iterator(begin()); }
 
 #if CPP_STANDARD > 2011
     constexpr const_iterator cbegin() const noexcept    { return data_ptr(); }
     constexpr const_iterator cend() const noexcept      { return data_ptr() + count_; }
+    constexpr const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    constexpr const_reverse_iterator crend() const noexcept { return rend(); }
 #endif
 
     template <typename In> 
@@ -189,6 +435,53 @@ public:
     iterator erase(iterator first, iterator last)       { return EraseRange(first, last); }
     iterator insert(iterator pos, const T& value)       { return Insert(pos, value); }
     iterator insert(iterator pos, T&& value)            { return Insert(pos, std::move(value)); }
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) { return Emplace(size_t(pos - data_ptr()), std::forward<Args>(args)...); }
+    [[nodiscard]] SboArrayStatus try_insert(iterator pos, const T& value) { return TryInsert(pos, value); }
+    [[nodiscard]] SboArrayStatus try_insert(iterator pos, T&& value)  { return TryInsert(pos, std::move(value)); }
+
+    // sorted, the array must already be sorted by comp
+    template <typename Compare = std::less<>>
+    iterator lower_bound(const T& value, Compare comp = Compare()) { return begin() + LowerBound(value, comp); }
+    // lower_bound of every key in keys (data()/size()), the indices are appended to out (an SboArray of an
+    //     integer type), 16 searches run interleaved so their cache misses overlap instead of queueing up
+    template <typename Keys, typename Out, typename Compare = std::less<>>
+    void lower_bound_batch(const Keys& keys, Out& out, Compare comp = Compare()) const { LowerBoundBatch(keys.data(), keys.size(), out, comp); }
+    template <typename Compare = std::less<>>
+    iterator insert_sorted(const T& value, Compare comp = Compare()) { return Insert(begin() + LowerBound(value, comp), value); }
+    template <typename Compare = std::less<>>
+    iterator insert_sorted(T&& value, Compare comp = Compare()) { size_t i = LowerBound(value, comp); return Insert(begin() + i, std::move(value)); }
+
+    // sorts a copy of [first, last) then merges it in from the back, O(n + k) moves instead of k inserts
+    template <typename InputIt, typename Compare = std::less<>>
+    void insert_sorted_batch(InputIt first, InputIt last, Compare comp = Compare()) { InsertSortedBatch(first, last, comp); }
+    template <typename Compare = std::less<>>
+    void insert_sorted_batch(std::initializer_list<T> init, Compare comp = Compare()) { InsertSortedBatch(init.begin(), init.end(), comp); }
+
+    // merges the sorted runs [begin(), mid) and [mid, end()), the spare capacity past end() is the buffer
+    template <typename Compare = std::less<>>
+    void inplace_merge(iterator mid, Compare comp = Compare()) { InplaceMerge(mid, comp); }
+
+#if CPP_STANDARD > 2017
+    // ranges, SboArray is a contiguous_range and sized_range, spans and views over it are zero copy
+    //     sized sources reserve once, contiguous sources of pod are a single memcpy
+    std::span<T> as_span() noexcept                     { return std::span<T>(data_ptr(), count_); }
+    std::span<const T> as_span() const noexcept         { return std::span<const T>(data_ptr(), count_); }
+    operator std::span<T>() noexcept                    { return as_span(); }
+    operator std::span<const T>() const noexcept        { return as_span(); }
+
+    template <std::ranges::input_range R>
+    void append_range(R&& range)                        { AppendRange(range); }
+    template <std::ranges::input_range R>
+    void assign_range(R&& range)                        { clear(); AppendRange(range); }
+    template <std::ranges::input_range R>
+    iterator insert_range(const_iterator pos, R&& range) { return InsertRangeFrom(size_t(pos - data_ptr()), range); }
+
+    #ifdef __cpp_lib_ranges_to_container
+    template <std::ranges::input_range R>
+    SboArray(std::from_range_t, R&& range)              { ContainerConstructor(); AppendRange(range); }
+    #endif
+#endif
 
 //=====================================================================================================================
 // Underlying Data
@@ -196,20 +489,27 @@ public:
     
 private:
     // Data is a union between a pre known sized array and a T*
+    //     the buffer is aligned for T, a plain char array is only as aligned as the pointer next to it
     union Storage 
     {
-        char stack_buffer[size_threshold * sizeof(T)] = {0};
+        alignas(T) char stack_buffer[size_threshold * sizeof(T)] = {0};
         T* heap_ptr;
     };
     Storage storage_;
     size_t count_ = 0;
     size_t capacity_ = size_threshold;
     bool using_heap_ = false;
+    uint8_t trim_cycles_ = 0;       // auto trim, 0 is off, these sit in the padding after using_heap_
+    uint8_t trim_percent_ = 25;
+    uint8_t low_cycles_ = 0;
+    bool arena_owned_ = false;      // heap_ptr is a slice of an SboHeapCompactor arena, released, never freed
     T* cached_data_ptr_ = nullptr;
     static constexpr bool plain_old_data_ = std::is_trivially_copyable_v<T> &&
                                             std::is_trivially_default_constructible_v<T> &&
                                             std::is_trivially_destructible_v<T> &&
                                             std::is_trivially_move_constructible_v<T>;
+    static constexpr bool relocatable_ = plain_old_data_ || SboRelocatable<T>::value;
+    static constexpr size_t npos_ = size_t(-1);
                                      
 
     static_assert
@@ -259,6 +559,8 @@ private:
     { 
         count_ = 0; 
         capacity_ = ((size <= size_threshold) ? size_threshold : size);
+        using_heap_ = capacity_ > size_threshold;
+        if (using_heap_) { SBOARRAY_STAT(spills, 1); storage_.heap_ptr = MallocOrFail(capacity_); }
         UpdateDataPointer();
         
         // default construct objects that require it
@@ -272,6 +574,8 @@ private:
     { 
         count_ = 0; 
         capacity_ = ((size <= size_threshold) ? size_threshold : size);
+        using_heap_ = capacity_ > size_threshold;
+        if (using_heap_) { SBOARRAY_STAT(spills, 1); storage_.heap_ptr = MallocOrFail(capacity_); }
         UpdateDataPointer();
         for (size_t i = 0; i < size; ++i) { new (data_ptr() + i) T(value); }
         count_ = size;
@@ -281,7 +585,7 @@ private:
         count_ = (rhs.count_);
         capacity_ = (rhs.capacity_);
         using_heap_ = capacity_ > size_threshold;
-        if (using_heap_) { storage_.heap_ptr = Malloc(capacity_); }
+        if (using_heap_) { SBOARRAY_STAT(spills, 1); storage_.heap_ptr = MallocOrFail(capacity_); }
         UpdateDataPointer();
         CopyElements(data_ptr(), rhs.data_ptr(), count_);
         UpdateDataPointer();
@@ -293,7 +597,8 @@ private:
         using_heap_ = rhs.using_heap_; 
         UpdateDataPointer();
         
-        if (using_heap_) { storage_.heap_ptr = rhs.storage_.heap_ptr; }
+        // an arena slice changes hands like any heap buffer, the arena lives until its last borrower lets go
+        if (using_heap_) { storage_.heap_ptr = rhs.storage_.heap_ptr; arena_owned_ = rhs.arena_owned_; }
         UpdateDataPointer();
         if (!using_heap_) { MoveElements(data_ptr(), rhs.data_ptr(), rhs.count_); }
         
@@ -302,6 +607,8 @@ private:
         rhs.count_ = 0;
         rhs.capacity_ = size_threshold; 
         rhs.using_heap_ = false;
+        rhs.arena_owned_ = false;
+        rhs.UpdateDataPointer();
         UpdateDataPointer();
     }
     inline void ContainerConstructor_List(std::initializer_list<T> init) 
@@ -309,9 +616,9 @@ private:
         count_ = (init.size());
         capacity_ = (init.size());
         using_heap_ = capacity_ > size_threshold;
+        if (using_heap_) { SBOARRAY_STAT(spills, 1); storage_.heap_ptr = MallocOrFail(capacity_); }
         UpdateDataPointer();
         
-        if (using_heap_) { storage_.heap_ptr = Malloc(capacity_); }
         size_t i = 0;
         for (const T& val : init) { Construct(data_ptr() + i, val); ++i; }
         UpdateDataPointer();
@@ -338,20 +645,65 @@ private:
             
             if (using_heap_) { Free(storage_.heap_ptr); }
             
-            storage_ = rhs.storage_;
             count_ = rhs.count_;
             capacity_ = rhs.capacity_;
             using_heap_ = rhs.using_heap_;
             
+            // steal the heap buffer (an arena slice too), but stack elements have to be moved, a bitwise copy
+            //     breaks any T that points into itself (SboArray<SboArray<T>> for one)
+            if (using_heap_) { storage_.heap_ptr = rhs.storage_.heap_ptr; arena_owned_ = rhs.arena_owned_; }
+            UpdateDataPointer();
+            if (!using_heap_) { MoveElements(data_ptr(), rhs.data_ptr(), rhs.count_); }
+            
             rhs.storage_.heap_ptr = nullptr;
             rhs.count_ = 0;
             rhs.capacity_ = size_threshold;
             rhs.using_heap_ = false;
+            rhs.arena_owned_ = false;
+            rhs.UpdateDataPointer();
         }
         UpdateDataPointer();
         return *this;
     }
 
+    template <size_t other_threshold>
+    inline SboArray& ContainerAssignment_Convert(SboArray<T, other_threshold>& rhs)
+    {
+        CallDestructors();
+        if (using_heap_) { Free(storage_.heap_ptr); }
+        count_ = 0;
+        capacity_ = size_threshold;
+        using_heap_ = false;
+        UpdateDataPointer();
+        ConvertFrom(rhs);
+        return *this;
+    }
+
+    // this is an empty stack array when called, rhs is left as one
+    //     every SboArray<T, N> gets its blocks from the same Malloc, so a heap buffer can change hands as is
+    //     as long as it is past our threshold (capacity_ > size_threshold is what using_heap_ means)
+    template <size_t other_threshold>
+    inline void ConvertFrom(SboArray<T, other_threshold>& rhs)
+    {
+        const bool steal = rhs.using_heap_ && rhs.capacity_ > size_threshold;
+        if (steal) { storage_.heap_ptr = rhs.storage_.heap_ptr; capacity_ = rhs.capacity_; using_heap_ = true; arena_owned_ = rhs.arena_owned_; }
+        else if (rhs.count_ > size_threshold) { SBOARRAY_STAT(spills, 1); storage_.heap_ptr = MallocOrFail(rhs.count_); capacity_ = rhs.count_; using_heap_ = true; }
+        UpdateDataPointer();
+        
+        if (!steal)
+        {
+            MoveElements(data_ptr(), rhs.data_ptr(), rhs.count_);
+            if (rhs.using_heap_) { rhs.Free(rhs.storage_.heap_ptr); }
+        }
+        count_ = rhs.count_;
+        
+        rhs.count_ = 0;
+        rhs.capacity_ = other_threshold;
+        rhs.using_heap_ = false;
+        rhs.arena_owned_ = false;
+        rhs.UpdateDataPointer();
+    }
+
     inline void ContainerDestructor() 
     { 
         CallDestructors(); 
@@ -365,47 +717,259 @@ private:
     
     inline T& At(size_t i) 
     {
-        if (i >= count_) throw std::out_of_range("SboArray::at index out of range");
+        if (i >= count_) { OutOfRange(); }
         return data_ptr()[i];
     }
     inline const T& At(size_t i) const 
     {
-        if (i >= count_) throw std::out_of_range("SboArray::at index out of range");
+        if (i >= count_) { OutOfRange(); }
         return data_ptr()[i];
     }
 
           
 // Mutate
-    inline void Reserve(size_t new_cap) { if (new_cap > capacity_) { Resize(new_cap); } }
+    inline void Reserve(size_t new_cap) { if (!TryReserve(new_cap)) { OutOfMemory(); } }
+    inline bool TryReserve(size_t new_cap) noexcept { return (new_cap <= capacity_) || Resize(new_cap); }
+
+    // non binding, if the smaller block can not be had the array just keeps the one it has
     inline void ShrinkToFit() { if (count_ < capacity_) { Resize(count_); } }
-    inline void PushBack_Copy(const T& value) { CheckSize(); Construct(data_ptr() + count_, value); ++count_; }
-    inline void PushBack_Move(T&& value) { CheckSize(); MoveConstruct(data_ptr() + count_, std::move(value)); ++count_; }
-    inline void PopBack() noexcept { assert(count_ > 0); if_constexpr (!plain_old_data_) { data_ptr()[count_ - 1].~T(); } --count_; }
+    
+    template <typename Op>
+    inline void ResizeAndOverwrite(size_t n, Op& op)
+    {
+        static_assert(plain_old_data_, "SboArray::resize_and_overwrite needs plain old data, the tail is uninitialized");
+        Reserve(n);
+        const size_t new_count = static_cast<size_t>(op(data_ptr(), n));
+        assert(new_count <= n);
+        count_ = new_count;
+    }
+    inline void PushBack_Copy(const T& value) { EmplaceBack(value); }
+    inline void PushBack_Move(T&& value) { EmplaceBack(std::move(value)); }
+    inline void PopBack() noexcept 
+    { 
+        assert(count_ > 0); 
+        if_constexpr (!plain_old_data_) { data_ptr()[count_ - 1].~T(); } 
+        --count_; 
+        if (trim_cycles_) { TrackUsage(count_); }
+    }
+    inline void Clear() noexcept
+    {
+        const size_t used = count_;
+        CallDestructors();
+        count_ = 0;
+        if (trim_cycles_) { TrackUsage(used); }
+    }
+
+    // used is how full the array was this cycle, for clear() that is the count before it emptied
+    //     trims to twice used so the next few cycles have room to grow back without a realloc, and the
+    //     trigger (under percent, 25% by default) sits well below the 50% a trim leaves, that gap is the hysteresis
+    inline void TrackUsage(size_t used) noexcept
+    {
+        if (!using_heap_ || used * 100 >= capacity_ * trim_percent_) { low_cycles_ = 0; return; }
+        if (++low_cycles_ < trim_cycles_) { return; }
+
+        low_cycles_ = 0;
+        const size_t target = (used <= size_threshold) ? size_threshold : used * 2;
+        if (target < capacity_) { Resize(std::max(target, count_)); }   // non binding, keeps the old block if this fails
+    }
     
     template <typename... Args> 
-    inline void EmplaceBack(Args&&... args) { CheckSize(); new (data_ptr() + count_) T(std::forward<Args>(args)...); ++count_; }
+    inline T& EmplaceBack(Args&&... args) 
+    { 
+        if (count_ == capacity_) 
+        { 
+            T* slot = TryGrowAndEmplace(std::forward<Args>(args)...);
+            if (!slot) { OutOfMemory(); }
+            return *slot; 
+        }
+        return EmplaceBackUnchecked(std::forward<Args>(args)...); 
+    }
+    template <typename... Args>
+    inline T& EmplaceBackUnchecked(Args&&... args)
+    {
+        T* slot = new (data_ptr() + count_) T(std::forward<Args>(args)...);
+        ++count_;
+        return *slot;
+    }
+
+    template <typename F>
+    inline T& EmplaceBackWith(F& init)
+    {
+        CheckSize();
+        T* slot = data_ptr() + count_;
+        init(slot);
+        ++count_;
+        return *std::launder(slot);
+    }
+
+    // at the end it is built in place, in the middle the slot it goes into is still a live element, so it is
+    //     built once and moved in (what std::vector does too), still one move less than insert(pos, T(args...))
+    template <typename... Args>
+    inline iterator Emplace(size_t index, Args&&... args)
+    {
+        assert(index <= count_);
+        if (index == count_) { return &EmplaceBack(std::forward<Args>(args)...); }
+        T value(std::forward<Args>(args)...);
+        if (count_ == capacity_) { CheckSize(); }
+        return InsertMoved(index, value);
+    }
+
+    template <typename... Args>
+    inline SboArrayStatus TryEmplaceBack(Args&&... args)
+    {
+        if (count_ == capacity_)
+        {
+            return TryGrowAndEmplace(std::forward<Args>(args)...) ? SboArrayStatus::Ok : SboArrayStatus::OutOfMemory;
+        }
+        EmplaceBackUnchecked(std::forward<Args>(args)...);
+        return SboArrayStatus::Ok;
+    }
+
+    template <typename... Value>
+    inline bool TryResizeCount(size_t n, const Value&... value)
+    {
+        // grows like push_back, resize(size() + 1) in a loop is amortized O(1) too
+        //     value may be one of our own elements, growing relocates it, so it is looked up again by index afterwards
+        [[maybe_unused]] const size_t alias[] = { IndexOf(value)..., npos_ };
+        if (n > capacity_ && !Resize(std::max(n, NextCapacity()))) { return false; }
+        T* data = data_ptr();
+        if_constexpr (!plain_old_data_) { for (size_t i = n; i < count_; ++i) { data[i].~T(); } }
+        for (size_t i = count_; i < n; ++i) { new (data + i) T(Relocated(value, alias[0])...); }
+        count_ = n;
+        return true;
+    }
+    inline const T& Relocated(const T& value, size_t index) const noexcept { return (index == npos_) ? value : data_ptr()[index]; }
+
+    template <typename Init>
+    inline void InitSlice(size_t n, size_t slice, size_t slices, Init& init)
+    {
+        assert(n <= capacity_ && slice < slices);
+        const size_t first = std::max(count_, n * slice / slices);
+        const size_t last = std::max(count_, n * (slice + 1) / slices);
+        T* data = data_ptr();
+        for (size_t i = first; i < last; ++i) { init(data + i, i); }
+    }
+
+    template <typename Arg>
+    inline SboArrayStatus TryInsert(iterator pos, Arg&& arg)
+    {
+        if (pos < begin() || pos > end()) { return SboArrayStatus::OutOfRange; }
+        const size_t index = size_t(pos - begin());
+        if (index == count_) { return TryEmplaceBack(std::forward<Arg>(arg)); }
+
+        // arg may be one of our own elements, growing relocates it, so it is looked up again by index afterwards
+        //     and nothing has been moved from when the block can not be had
+        const size_t alias = IndexOf(arg);
+        if (!TryCheckSize()) { return SboArrayStatus::OutOfMemory; }
+        T value(alias == npos_ ? std::forward<Arg>(arg) : std::forward<Arg>(data_ptr()[alias]));
+        InsertMoved(index, value);
+        return SboArrayStatus::Ok;
+    }
           
 // Helper Functions
-    T* Malloc(size_t n)
+    // never throws, nullptr when the size overflows or the allocation fails
+    T* Malloc(size_t n) noexcept
     {
+        if (n > size_t(-1) / sizeof(T)) { return nullptr; }
+        SBOARRAY_STAT(allocations, 1);
+        SBOARRAY_STAT(bytes, n * sizeof(T));
         if_constexpr (plain_old_data_) { return static_cast<T*>(malloc(n * sizeof(T))); }
-        else { return static_cast<T*>(::operator new(n * sizeof(T))); }
+        else { return static_cast<T*>(::operator new(n * sizeof(T), std::nothrow)); }
+    }
+    // for the constructors, the array is still an empty stack array when this fails
+    T* MallocOrFail(size_t n)
+    {
+        T* ptr = Malloc(n);
+        if (!ptr) { using_heap_ = false; capacity_ = size_threshold; count_ = 0; UpdateDataPointer(); OutOfMemory(); }
+        return ptr;
     }
+    // frees this array's own heap block, an arena slice is only let go of
     void Free(T* ptr)
     {
         if (!ptr) return;
-        if_constexpr (plain_old_data_) { free(ptr); }
-        else { ::operator delete(ptr); }
+        if (arena_owned_) { arena_owned_ = false; SboArena::Release(ptr); return; }
+        Release(ptr);
     }
-    void CheckSize()
+    // the raw block from Malloc, for one that never made it into the array
+    static void Release(T* block) noexcept
     {
-        if (count_ == capacity_) 
-        {   
-            // @consider:: the user may want to tune the growth for memory constraints or faster growth
-            constexpr float growth_factor = 2.0f;
-            size_t new_cap = (capacity_ == 0) ? size_threshold : capacity_ * growth_factor;
-            Resize(new_cap);
-        }
+        SBOARRAY_STAT(frees, 1);
+        if_constexpr (plain_old_data_) { free(block); }
+        else { ::operator delete(block); }
+    }
+
+    // where value sits in the array, npos_ when it is not one of our elements
+    size_t IndexOf(const T& value) const noexcept
+    {
+        const std::less<const T*> before;
+        const T* data = data_ptr();
+        const T* ptr = std::addressof(value);
+        return (!before(ptr, data) && before(ptr, data + count_)) ? size_t(ptr - data) : npos_;
+    }
+
+    // growing by one at the back, the new element is built in the new block before the old one is let go (what
+    //     std::vector does), so args may still point into the array and nothing is touched when the block can not
+    //     be had, nullptr in that case
+    template <typename... Args>
+    T* TryGrowAndEmplace(Args&&... args)
+    {
+        assert(count_ == capacity_);
+        const size_t new_capacity = NextCapacity();
+        assert(new_capacity > size_threshold);
+        T* block = Malloc(new_capacity);
+        if (!block) { return nullptr; }
+
+        struct Guard
+        {
+            T* block;
+            ~Guard() { if (block) { Release(block); } }
+        } guard{ block };
+        T* slot = new (block + count_) T(std::forward<Args>(args)...);
+        guard.block = nullptr;
+
+        T* old_data = data_ptr();
+        MoveElements(block, old_data, count_);
+        if (using_heap_) { Free(old_data); }
+        else { SBOARRAY_STAT(spills, 1); }
+
+        storage_.heap_ptr = block;
+        using_heap_ = true;
+        capacity_ = new_capacity;
+        ++count_;
+        UpdateDataPointer();
+        return slot;
+    }
+
+    void CheckSize() { if (!TryCheckSize()) { OutOfMemory(); } }
+    bool TryCheckSize() noexcept
+    {
+        if (count_ == capacity_) { return Resize(NextCapacity()); }
+        return true;
+    }
+    size_t NextCapacity() const noexcept
+    {
+        // @consider:: the user may want to tune the growth for memory constraints or faster growth
+        constexpr float growth_factor = 2.0f;
+        return (capacity_ == 0) ? size_threshold : capacity_ * growth_factor;
+    }
+
+    [[noreturn]] static void OutOfMemory()
+    {
+    #ifdef SBOARRAY_NO_EXCEPTIONS
+        assert(!"SboArray out of memory");
+        std::abort();
+    #else
+        throw std::bad_alloc();
+    #endif
+    }
+    [[noreturn]] static void OutOfRange()
+    {
+    #ifdef SBOARRAY_NO_EXCEPTIONS
+        assert(!"SboArray::at index out of range");
+        std::abort();
+    #else
+        throw std::out_of_range("SboArray::at index out of range");
+    #endif
     }
     
 #if CPP_STANDARD > 2017
@@ -420,20 +984,21 @@ private:
         std::swap(count_, other.count_);
         std::swap(capacity_, other.capacity_);
         std::swap(using_heap_, other.using_heap_);
+        std::swap(arena_owned_, other.arena_owned_);
         UpdateDataPointer();
         other.UpdateDataPointer();
     }
     
     
-    // follows copy-and-swap idiom
-    void Resize(size_t new_cap)
+    // follows copy-and-swap idiom, false (and nothing changed) when the new block can not be allocated
+    bool Resize(size_t new_cap) noexcept
     {
         size_t new_capacity = std::max(new_cap, size_threshold);
         size_t number_of_elements_to_move = std::min(count_, new_capacity);
         bool will_use_heap = new_capacity > size_threshold;
         
         // already there
-        if ((new_capacity == capacity_) && (will_use_heap == using_heap_)) { return; }
+        if ((new_capacity == capacity_) && (will_use_heap == using_heap_)) { return true; }
         
         UpdateDataPointer();
         T* new_data = nullptr;
@@ -443,7 +1008,9 @@ private:
         {
             if(will_use_heap)
             {
-                new_data = Malloc(new_capacity);    
+                new_data = Malloc(new_capacity);
+                if (!new_data) { return false; }
+                if (!using_heap_) { SBOARRAY_STAT(spills, 1); }
             }
             else
             {
@@ -458,7 +1025,8 @@ private:
         }
                     
         // we got them all copied, now commit to the swap
-        CallDestructors();
+        //     MoveElements already destroyed what it moved, only the elements cut off by a shrink are left
+        if_constexpr (!plain_old_data_) { for (size_t i = number_of_elements_to_move; i < count_; ++i) { old_data[i].~T(); } }
         if(using_heap_) { Free(old_data); }
         if(will_use_heap) { storage_.heap_ptr = new_data; }
 
@@ -466,6 +1034,7 @@ private:
         capacity_ = new_capacity;
         count_ = number_of_elements_to_move;
         UpdateDataPointer();
+        return true;
     }
         
     void Construct(T* dest, const T& val)
@@ -479,11 +1048,20 @@ private:
         else { new (dest) T(std::move(val)); }
     }
     
+    // non overlapping bulk copy, the large copy engine takes over past its threshold when it is compiled in
+    static void CopyBytes(void* dest, const void* src, size_t bytes)
+    {
+    #ifdef SBOARRAY_LARGE_COPY
+        if (bytes >= SboLargeCopy::threshold) { SboLargeCopy::Copy(dest, src, bytes); return; }
+    #endif
+        std::memcpy(dest, src, bytes);
+    }
+
     void CopyElements(T* dest, const T* src, size_t n)
     {
         if_constexpr (plain_old_data_)
         {
-            std::memcpy(dest, src, n * sizeof(T));
+            CopyBytes(dest, src, n * sizeof(T));
         }
         else 
         {
@@ -493,11 +1071,13 @@ private:
             }
         }
     }
+    // relocate, dest ends up with the elements and src is left as raw memory
     void MoveElements(T* dest, T* src, size_t n)
     {
-        if_constexpr (plain_old_data_)
+        if_constexpr (relocatable_)
         {
-            std::memmove(dest, src, n * sizeof(T)); 
+            // the blocks only overlap when they are the same block (stack to stack of the same array)
+            if (dest != src) { CopyBytes(dest, src, n * sizeof(T)); }
         }
         else
         {
@@ -533,10 +1113,11 @@ private:
     {
         if (pos < begin() || pos >= end()) return end();
         
-        if_constexpr (plain_old_data_)
+        if_constexpr (relocatable_)
         {
+            if_constexpr (!plain_old_data_) { pos->~T(); }
             size_t n = count_ - (pos - begin()) - 1;
-            if (n > 0) { std::memmove(pos, pos + 1, n * sizeof(T)); }
+            if (n > 0) { std::memmove(static_cast<void*>(pos), pos + 1, n * sizeof(T)); }
         }
         else
         {   
@@ -554,10 +1135,19 @@ private:
         if (first < begin() || last > end() || first > last) { return end(); }
         if (first == last) { return first; }
         size_t n = last - first;
-        iterator new_end = std::move(last, end(), first);
-        
-        // call destructors after the move
-        if_constexpr (!plain_old_data_) { for(iterator it = new_end; it != end(); ++it) { it->~T(); } }        
+
+        if_constexpr (relocatable_)
+        {
+            if_constexpr (!plain_old_data_) { for (iterator it = first; it != last; ++it) { it->~T(); } }
+            std::memmove(static_cast<void*>(first), last, size_t(end() - last) * sizeof(T));
+        }
+        else
+        {
+            iterator new_end = std::move(last, end(), first);
+            
+            // call destructors after the move
+            for (iterator it = new_end; it != end(); ++it) { it->~T(); }
+        }
         
         count_ -= n;
         return first;
@@ -567,13 +1157,27 @@ private:
     iterator Insert(iterator pos, Arg&& arg) 
     {
         size_t index = pos - begin();
+        T value(std::forward<Arg>(arg));    // before growing, arg may be one of our own elements
         if (count_ == capacity_) CheckSize();
-        pos = begin() + index; 
+        return InsertMoved(index, value);
+    }
+
+    // capacity is already there, value is moved into slot index
+    iterator InsertMoved(size_t index, T& value)
+    {
+        T* data = data_ptr();
+        T* pos = data + index;
         
-        if_constexpr (plain_old_data_) { std::memmove(pos + 1, pos, (count_ - index) * sizeof(T)); } 
-        else { std::move_backward(pos, end(), end() + 1); }
+        if_constexpr (relocatable_) { std::memmove(static_cast<void*>(pos + 1), pos, (count_ - index) * sizeof(T)); new (pos) T(std::move(value)); }
+        else if (index == count_) { new (pos) T(std::move(value)); }
+        else
+        {
+            // the last element moves into the raw slot past end(), everything else shifts inside the live range
+            new (data + count_) T(std::move(data[count_ - 1]));
+            std::move_backward(pos, data + count_ - 1, data + count_);
+            *pos = std::move(value);
+        }
         
-        Construct(pos, std::forward<Arg>(arg)); 
         ++count_;
         return pos;
     }
@@ -582,8 +1186,9 @@ private:
     iterator InsertRange(iterator pos, InputIt first, InputIt last) 
     {
         size_t index = pos - begin();
-        auto n = std::distance(first, last);
-        if(n <= 0) { return pos; }
+        auto distance = std::distance(first, last);
+        if(distance <= 0) { return pos; }
+        const size_t n = size_t(distance);
         
         if (count_ + n > capacity_) 
         {
@@ -591,16 +1196,259 @@ private:
             pos = begin() + index; 
         }
         
-        if_constexpr (plain_old_data_) { std::memmove(pos + n, pos, (count_ - index) * sizeof(T)); } 
-        else { std::move_backward(pos, end(), end() + n); }
-        
-        for (iterator it = pos; first != last; ++first, ++it) { Construct(it, *first); }  
+        if_constexpr (relocatable_) 
+        { 
+            // the gap is raw memory after a bulk shift
+            std::memmove(static_cast<void*>(pos + n), pos, (count_ - index) * sizeof(T)); 
+            for (iterator it = pos; first != last; ++first, ++it) { new (it) T(*first); }
+        } 
+        else 
+        { 
+            // tail elements landing past the old end() are move constructed into raw slots, the rest are move
+            //     assigned over live ones, then the gap is assigned where it overlaps the old live range and
+            //     constructed where it does not
+            T* data = data_ptr();
+            for (size_t src = count_; src > index; --src)
+            {
+                const size_t dest = src - 1 + n;
+                if (dest >= count_) { new (data + dest) T(std::move(data[src - 1])); }
+                else { data[dest] = std::move(data[src - 1]); }
+            }
+            for (size_t i = index; first != last; ++first, ++i)
+            {
+                if (i < count_) { data[i] = *first; }
+                else { new (data + i) T(*first); }
+            }
+        }
         
         count_ += n;
         return pos;
     }
+
+//=====================================================================================================================
+// Ranges
+//=====================================================================================================================
+
+#if CPP_STANDARD > 2017
+    template <typename R>
+    void AppendRange(R& range)
+    {
+        using Source = std::ranges::range_value_t<R>;
+        if_constexpr (plain_old_data_ && std::ranges::contiguous_range<R> && std::ranges::sized_range<R> && std::is_same_v<Source, T>)
+        {
+            const size_t n = size_t(std::ranges::size(range));
+            Reserve(count_ + n);
+            if (n != 0) { CopyBytes(data_ptr() + count_, std::ranges::data(range), n * sizeof(T)); }
+            count_ += n;
+        }
+        else
+        {
+            if_constexpr (std::ranges::sized_range<R>) { Reserve(count_ + size_t(std::ranges::size(range))); }
+            for (auto&& value : range) { emplace_back(std::forward<decltype(value)>(value)); }
+        }
+    }
+
+    template <typename R>
+    iterator InsertRangeFrom(size_t index, R& range)
+    {
+        assert(index <= count_);
+        if_constexpr (std::ranges::forward_range<R> && std::ranges::common_range<R>)
+        {
+            return InsertRange(begin() + index, std::ranges::begin(range), std::ranges::end(range));
+        }
+        else
+        {
+            // single pass or sentinel ended, gather it first so InsertRange knows how much room to make
+            SboArray<T, 64> gathered;
+            gathered.AppendRange(range);
+            return InsertRange(begin() + index, std::make_move_iterator(gathered.begin()), std::make_move_iterator(gathered.end()));
+        }
+    }
+#endif
+
+//=====================================================================================================================
+// Compaction, only called by SboHeapCompactor
+//=====================================================================================================================
+
+    // bytes this array wants in the arena, 0 when it is on the stack or small enough to go back to it
+    inline size_t CompactBytes() const noexcept { return (using_heap_ && count_ > size_threshold) ? count_ * sizeof(T) : 0; }
+
+    // moves the elements into dest (raw, count_ slots, a slice of an arena), or back into the stack buffer
+    //     when dest is null, capacity becomes count_ so the next growth leaves the arena
+    inline void CompactInto(T* dest) noexcept
+    {
+        if (!using_heap_) { return; }
+        if (!dest) { assert(count_ <= size_threshold); Resize(count_); return; }
+
+        T* old_data = data_ptr();
+        MoveElements(dest, old_data, count_);
+        Free(old_data);
+        storage_.heap_ptr = dest;
+        capacity_ = count_;
+        arena_owned_ = true;
+        UpdateDataPointer();
+    }
+
+    // a block of its own again, lets go of its slice, false (and still in the arena) if that fails
+    inline bool DetachFromArena() noexcept
+    {
+        if (!arena_owned_) { return true; }
+        T* block = Malloc(capacity_);
+        if (!block) { return false; }
+        T* old_data = data_ptr();
+        MoveElements(block, old_data, count_);
+        Free(old_data);
+        storage_.heap_ptr = block;
+        UpdateDataPointer();
+        return true;
+    }
+
+//=====================================================================================================================
+// Sorted
+//=====================================================================================================================
+
+    // branchless, the loop is a fixed log2(n) steps of cmov, nothing for the branch predictor to miss
+    template <typename Compare>
+    inline size_t LowerBound(const T& value, Compare& comp) const
+    {
+        if (count_ == 0) { return 0; }
+        const T* base = data_ptr();
+        size_t n = count_;
+        while (n > 1)
+        {
+            const size_t half = n / 2;
+            base = comp(base[half], value) ? base + half : base;
+            n -= half;
+        }
+        return size_t(base - data_ptr()) + size_t(comp(*base, value));
+    }
+
+    // the branchless search takes the same log2(n) steps for every key, so a group can run in lockstep, each step
+    //     issues the probes of the whole group and prefetches where each one goes next, by the time a search
+    //     comes back around its line is (usually) there, 16 misses in flight instead of 1
+    template <typename Out, typename Compare>
+    inline void LowerBoundBatch(const T* keys, size_t key_count, Out& out, Compare& comp) const
+    {
+        using Index = typename Out::value_type;
+        constexpr size_t group = 16;
+        const size_t old_size = out.size();
+        const T* const data = data_ptr();
+
+        out.resize_and_overwrite(old_size + key_count, [&](Index* results, size_t)
+        {
+            Index* write = results + old_size;
+            for (size_t first = 0; first < key_count; first += group)
+            {
+                const size_t m = std::min(group, key_count - first);
+                const T* key = keys + first;
+                if (count_ == 0) { for (size_t k = 0; k < m; ++k) { write[first + k] = Index(0); } continue; }
+
+                const T* base[group];
+                for (size_t k = 0; k < m; ++k) { base[k] = data; }
+                for (size_t n = count_; n > 1; )
+                {
+                    const size_t half = n / 2;
+                    const size_t next = (n - half) / 2;
+                    for (size_t k = 0; k < m; ++k)
+                    {
+                        base[k] = comp(base[k][half], key[k]) ? base[k] + half : base[k];
+                        SBOARRAY_PREFETCH(base[k] + next);
+                    }
+                    n -= half;
+                }
+                for (size_t k = 0; k < m; ++k) { write[first + k] = Index(size_t(base[k] - data) + size_t(comp(*base[k], key[k]))); }
+            }
+            return old_size + key_count;
+        });
+    }
+
+    template <typename InputIt, typename Compare>
+    void InsertSortedBatch(InputIt first, InputIt last, Compare& comp)
+    {
+        SboArray<T, 64> batch;
+        for (; first != last; ++first) { batch.push_back(*first); }
+        if (batch.empty()) { return; }
+        std::sort(batch.begin(), batch.end(), comp);
+
+        const size_t old_count = count_;
+        const size_t k = batch.size();
+        Reserve(old_count + k);
+
+        // merge from the back into the grown tail, slots >= old_count are raw memory the first time they are
+        //     written, equal elements keep the existing ones first
+        T* data = data_ptr();
+        size_t write = old_count + k;
+        size_t i = old_count;
+        size_t j = k;
+        while (j > 0)
+        {
+            --write;
+            T& from = (i > 0 && comp(batch[j - 1], data[i - 1])) ? data[--i] : batch[--j];
+            if (write >= old_count) { MoveConstruct(data + write, std::move(from)); }
+            else { data[write] = std::move(from); }
+        }
+        count_ = old_count + k;
+    }
+
+    template <typename Compare>
+    void InplaceMerge(iterator mid, Compare& comp)
+    {
+        assert(mid >= begin() && mid <= end());
+        const size_t left = size_t(mid - begin());
+        const size_t right = count_ - left;
+        if (left == 0 || right == 0) { return; }
+
+        // already in order, the common case for a list that only got a few late additions
+        if (!comp(*mid, *(mid - 1))) { return; }
+
+        // the smaller run goes into the spare capacity, grow once if there is not enough of it
+        const size_t buffered = std::min(left, right);
+        if (capacity_ - count_ < buffered)
+        {
+            const size_t index = left;
+            Reserve(count_ + buffered);
+            mid = begin() + index;
+        }
+
+        T* data = data_ptr();
+        T* buffer = data + count_;
+        if (left <= right)
+        {
+            // left run to the buffer, merge forward, the write cursor never passes the right run's read cursor
+            for (size_t i = 0; i < left; ++i) { MoveConstruct(buffer + i, std::move(data[i])); }
+            T* a = buffer;
+            T* const a_end = buffer + left;
+            T* b = data + left;
+            T* const b_end = data + count_;
+            T* out = data;
+            while (a != a_end)
+            {
+                if (b != b_end && comp(*b, *a)) { *out++ = std::move(*b++); }
+                else { *out++ = std::move(*a++); }
+            }
+        }
+        else
+        {
+            // right run to the buffer, merge backward
+            for (size_t i = 0; i < right; ++i) { MoveConstruct(buffer + i, std::move(data[left + i])); }
+            T* a = data + left;
+            T* b = buffer + right;
+            T* out = data + count_;
+            while (b != buffer)
+            {
+                if (a != data && comp(*(b - 1), *(a - 1))) { *--out = std::move(*--a); }
+                else { *--out = std::move(*--b); }
+            }
+        }
+
+        if_constexpr (!plain_old_data_) { for (size_t i = 0; i < buffered; ++i) { buffer[i].~T(); } }
+    }
     
 }; 
 
 
+#if CPP_STANDARD > 2017
+static_assert(std::ranges::contiguous_range<SboArray<int>> && std::ranges::sized_range<SboArray<int>>, "SboArray should model contiguous_range and sized_range");
+#endif
+
 #endif // SBOARRAY_H
@@ -0,0 +1,308 @@
+//=====================================================================================================================
+// MIT License
+//
+// Copyright (c) 2025 Cory Simonich
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//=====================================================================================================================
+
+//=====================================================================================================================
+//
+// Callback List
+//
+//
+// event subscribers without std::function
+//     SboFunction       move only, type erased callable stored inline, captures up to inline_bytes never touch the
+//                       heap (bigger ones are a compile error, raise inline_bytes instead)
+//     SboCallbackList   the subscriber list, one SboArray of SboFunctions, dispatch is a loop over contiguous
+//                       storage with one indirect call per listener
+//
+// listeners may add and remove listeners (themselves included) while a dispatch is running
+//     removing only marks the slot dead, the dead slots are compacted out (and their callables destroyed) when
+//     the outermost dispatch returns
+//     adding goes to a pending list that is merged when the outermost dispatch returns, so a listener added
+//     during a dispatch is first called on the next one, and the array being walked never reallocates
+//     the merge runs from a destructor, so it never allocates, pending_ keeps room for every listener instead
+//
+// Example:
+//
+//      SboCallbackList<void(u32 entity, float damage)> on_damage;
+//      auto handle = on_damage.add([this](u32 e, float d) { OnDamage(e, d); });
+//      on_damage.dispatch(target, 12.0f);
+//      on_damage.remove(handle);
+//
+//=====================================================================================================================
+
+
+#ifndef SBOCALLBACKLIST_H
+#define SBOCALLBACKLIST_H
+
+#include "sbo_array.h"
+
+#include <algorithm>    // max, rotate
+#include <cstddef>      // max_align_t
+#include <cstdint>      // uint32_t
+#include <utility>      // forward, move
+
+//=====================================================================================================================
+// SboFunction
+//=====================================================================================================================
+
+template <typename Signature, size_t inline_bytes = 32>
+class SboFunction;
+
+template <typename R, typename... Args, size_t inline_bytes>
+class SboFunction<R(Args...), inline_bytes>
+{
+public:
+    SboFunction()                                       = default;
+    SboFunction(SboFunction&& rhs) noexcept             { MoveFrom(rhs); }
+    SboFunction& operator=(SboFunction&& rhs) noexcept  { if (this != &rhs) { Reset(); MoveFrom(rhs); } return *this; }
+    SboFunction(const SboFunction&)                     = delete;
+    SboFunction& operator=(const SboFunction&)          = delete;
+    ~SboFunction()                                      { Reset(); }
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, SboFunction>>>
+    SboFunction(F&& f)                                  { Assign(std::forward<F>(f)); }
+
+    R operator()(Args... args) const                    { assert(invoke_); return invoke_(storage_, std::forward<Args>(args)...); }
+    explicit operator bool() const noexcept             { return invoke_ != nullptr; }
+    void reset() noexcept                               { Reset(); }
+
+private:
+    enum class Op { Move, Destroy };
+
+    using Invoke = R (*)(void*, Args&&...);
+    using Manage = void (*)(Op, void* self, void* other);
+
+    // the invoke pointer is the only thing dispatch touches, manage is null for trivially relocatable callables
+    Invoke invoke_ = nullptr;
+    Manage manage_ = nullptr;
+    alignas(std::max_align_t) mutable unsigned char storage_[inline_bytes];
+
+    template <typename F>
+    void Assign(F&& f)
+    {
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= inline_bytes, "SboFunction callable does not fit inline_bytes, raise inline_bytes");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "SboFunction callable is over aligned");
+        static_assert(std::is_nothrow_move_constructible_v<Fn>, "SboFunction requires a nothrow move constructible callable");
+
+        new (storage_) Fn(std::forward<F>(f));
+        invoke_ = [](void* self, Args&&... args) -> R { return (*std::launder(reinterpret_cast<Fn*>(self)))(std::forward<Args>(args)...); };
+
+        if_constexpr (!(std::is_trivially_copyable_v<Fn> && std::is_trivially_destructible_v<Fn>))
+        {
+            manage_ = [](Op op, void* self, void* other)
+            {
+                Fn* fn = std::launder(reinterpret_cast<Fn*>(self));
+                if (op == Op::Move) { new (other) Fn(std::move(*fn)); }
+                fn->~Fn();
+            };
+        }
+    }
+
+    void MoveFrom(SboFunction& rhs) noexcept
+    {
+        invoke_ = rhs.invoke_;
+        manage_ = rhs.manage_;
+        if (manage_) { manage_(Op::Move, rhs.storage_, storage_); }
+        else if (invoke_) { std::memcpy(storage_, rhs.storage_, inline_bytes); }
+        rhs.invoke_ = nullptr;
+        rhs.manage_ = nullptr;
+    }
+
+    void Reset() noexcept
+    {
+        if (manage_) { manage_(Op::Destroy, storage_, nullptr); }
+        invoke_ = nullptr;
+        manage_ = nullptr;
+    }
+};
+
+//=====================================================================================================================
+// SboCallbackList
+//=====================================================================================================================
+
+template <typename Signature, size_t size_threshold = 8, size_t inline_bytes = 32>
+class SboCallbackList;
+
+template <typename... Args, size_t size_threshold, size_t inline_bytes>
+class SboCallbackList<void(Args...), size_threshold, inline_bytes>
+{
+public:
+    using Function = SboFunction<void(Args...), inline_bytes>;
+    using Handle = uint32_t;
+    static constexpr Handle invalid_handle = 0;
+
+    SboCallbackList()                                   = default;
+    SboCallbackList(const SboCallbackList&)             = delete;
+    SboCallbackList& operator=(const SboCallbackList&)  = delete;
+
+    template <typename F>
+    Handle add(F&& f)                                   { return Add(Function(std::forward<F>(f))); }
+    bool remove(Handle handle) noexcept                 { return Remove(handle); }
+    void clear() noexcept                               { Clear(); }
+
+    // listeners are called in the order they were added
+    void dispatch(Args... args)                         { Dispatch(args...); }
+    void operator()(Args... args)                       { Dispatch(args...); }
+
+    // live listeners, including ones added during the current dispatch
+    size_t size() const noexcept                        { return live_count_; }
+    bool empty() const noexcept                         { return live_count_ == 0; }
+    bool dispatching() const noexcept                   { return dispatch_depth_ != 0; }
+    inline bool using_stack_buffer() const noexcept     { return slots_.using_stack_buffer() && pending_.using_stack_buffer(); }
+
+//=====================================================================================================================
+// Underlying Data
+//=====================================================================================================================
+
+private:
+    struct Slot
+    {
+        Function fn;
+        Handle handle;
+    };
+
+    SboArray<Slot, size_threshold> slots_;
+    SboArray<Slot, 1> pending_;             // added while dispatching
+    size_t live_count_ = 0;
+    uint32_t dispatch_depth_ = 0;
+    bool needs_compact_ = false;
+    Handle next_handle_ = 1;
+
+//=====================================================================================================================
+// Implementation
+//=====================================================================================================================
+
+    inline Handle Add(Function&& fn)
+    {
+        const Handle handle = next_handle_++;
+        if (next_handle_ == invalid_handle) { ++next_handle_; }
+
+        if (dispatch_depth_ != 0)
+        {
+            // room for slots_ too, so the merge in Compact can always be done in pending_ without allocating
+            const size_t needed = slots_.size() + pending_.size() + 1;
+            if (pending_.capacity() < needed) { pending_.reserve(std::max(needed, pending_.capacity() * 2)); }
+            pending_.push_back({ std::move(fn), handle });
+        }
+        else { slots_.push_back({ std::move(fn), handle }); }
+        ++live_count_;
+        return handle;
+    }
+
+    inline bool Remove(Handle handle) noexcept
+    {
+        if (handle == invalid_handle) { return false; }
+        if (RemoveFrom(pending_, handle)) { return true; }
+
+        for (Slot& slot : slots_)
+        {
+            if (slot.handle != handle) { continue; }
+
+            // a dead slot keeps its place (and its callable, it may be the one running) until the dispatch that
+            //     might be walking over it is done
+            slot.handle = invalid_handle;
+            if (dispatch_depth_ != 0) { needs_compact_ = true; }
+            else { slots_.erase(&slot); }
+            --live_count_;
+            return true;
+        }
+        return false;
+    }
+
+    template <typename Array>
+    inline bool RemoveFrom(Array& array, Handle handle) noexcept
+    {
+        for (Slot& slot : array)
+        {
+            if (slot.handle == handle) { array.erase(&slot); --live_count_; return true; }
+        }
+        return false;
+    }
+
+    inline void Clear() noexcept
+    {
+        pending_.clear();
+        live_count_ = 0;
+        if (dispatch_depth_ == 0) { slots_.clear(); return; }
+
+        for (Slot& slot : slots_) { slot.handle = invalid_handle; }
+        needs_compact_ = true;
+    }
+
+    // leaves dispatch mode even when a listener throws, otherwise adds would sit in pending_ for good
+    struct DispatchScope
+    {
+        SboCallbackList& list;
+        explicit DispatchScope(SboCallbackList& l) : list(l) { ++list.dispatch_depth_; }
+        ~DispatchScope()                                { if (--list.dispatch_depth_ == 0) { list.Compact(); } }
+    };
+
+    void Dispatch(Args... args)
+    {
+        DispatchScope scope(*this);
+
+        // slots_ never grows while dispatch_depth_ != 0, so walking it by pointer is safe
+        Slot* slot = slots_.data();
+        Slot* const end = slot + slots_.size();
+        for (; slot != end; ++slot)
+        {
+            if (slot->handle != invalid_handle) { slot->fn(args...); }
+        }
+    }
+
+    // only at the end of the outermost dispatch, from DispatchScope's destructor, nothing in here allocates
+    void Compact() noexcept
+    {
+        if (needs_compact_)
+        {
+            Slot* write = slots_.data();
+            for (Slot& slot : slots_)
+            {
+                if (slot.handle == invalid_handle) { continue; }
+                if (write != &slot) { *write = std::move(slot); }
+                ++write;
+            }
+            slots_.erase(write, slots_.end());
+            needs_compact_ = false;
+        }
+
+        if (pending_.empty()) { return; }
+        if (slots_.capacity() - slots_.size() >= pending_.size())
+        {
+            for (Slot& slot : pending_) { slots_.push_back(std::move(slot)); }
+            pending_.clear();
+            return;
+        }
+
+        // slots_ is full, pending_ was reserved for both, so the listeners go in behind the pending ones, are
+        //     rotated to the front to keep the order, and pending_'s block becomes the list
+        const size_t added = pending_.size();
+        for (Slot& slot : slots_) { pending_.push_back(std::move(slot)); }
+        std::rotate(pending_.begin(), pending_.begin() + added, pending_.end());
+        slots_ = std::move(pending_);
+        pending_.clear();
+    }
+};
+
+#endif // SBOCALLBACKLIST_H
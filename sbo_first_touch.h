@@ -0,0 +1,131 @@
+//=====================================================================================================================
+// MIT License
+//
+// Copyright (c) 2025 Cory Simonich
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//=====================================================================================================================
+
+//=====================================================================================================================
+//
+// First Touch
+//
+//
+// numa aware initialization for big spilled arrays
+//     linux puts a page on the node of the thread that first writes it, an array filled by one thread ends up
+//     entirely on that thread's socket and every other socket's workers read it remotely
+//     reserve_and_init builds the new elements on the caller's own workers, worker i writes slice i of [0, n),
+//     the same even split a parallel loop over the array uses, so those loops read node local pages
+//
+// no threads are started here, the placement is only as good as the pinning of the workers, so the ones that
+//     touch a slice have to be the same (pinned) workers that use it later, run(slice_fn, slices) hands the
+//     slices to them, it calls slice_fn(i) on worker i for every i in [0, slices) and returns once all are done
+//
+// define SBOFIRSTTOUCH_NUMA and link libnuma to also mbind the new pages MPOL_LOCAL before touching them, that
+//     overrides a process wide policy (numactl --interleave, ...), skipped on single node machines, anything
+//     that fails falls back to plain first touch
+//
+// Example:
+//
+//      SboFirstTouch first_touch;
+//      SboArray<Particle, 64> particles;
+//      first_touch.reserve_and_init(particles, 50'000'000, job_system.worker_count(),
+//          [&](auto&& slice_fn, size_t slices) { job_system.run_on_each_worker(slices, slice_fn); },
+//          [](Particle* p, size_t i) { new (p) Particle(i); });
+//
+//=====================================================================================================================
+
+
+#ifndef SBOFIRSTTOUCH_H
+#define SBOFIRSTTOUCH_H
+
+#include "sbo_array.h"
+
+#include <cstdint>      // uintptr_t
+
+#if defined(SBOFIRSTTOUCH_NUMA) && defined(__linux__) && defined(__has_include)
+    #if __has_include(<numa.h>) && __has_include(<numaif.h>)
+        #include <numa.h>
+        #include <numaif.h>
+        #define SBOFIRSTTOUCH_MBIND 1
+    #endif
+#endif
+#ifndef SBOFIRSTTOUCH_MBIND
+    #define SBOFIRSTTOUCH_MBIND 0
+#endif
+
+class SboFirstTouch
+{
+
+//=====================================================================================================================
+// Public Api
+//=====================================================================================================================
+public:
+    // below parallel_bytes of new elements the calling thread builds them all, run is not called
+    explicit SboFirstTouch(size_t parallel_bytes = size_t(1) << 20) : parallel_bytes_(parallel_bytes) {}
+    void set_parallel_bytes(size_t parallel_bytes) noexcept { parallel_bytes_ = parallel_bytes; }
+
+    // grows array to n, init(T* slot, size_t index) builds every new element, init must not throw
+    //     run(slice_fn, slices) calls slice_fn(size_t slice) once per slice on the caller's worker of that index
+    //     existing elements are moved by the calling thread, start from an empty array to place every page
+    template <typename T, size_t N, typename Run, typename Init>
+    void reserve_and_init(SboArray<T, N>& array, size_t n, size_t slices, Run&& run, Init&& init) const
+    {
+        if (n <= array.size()) { return; }
+        array.begin_first_touch(n);
+        const size_t bytes = (n - array.size()) * sizeof(T);
+        if (slices < 2 || bytes < parallel_bytes_) { array.init_slice(n, 0, 1, init); array.end_first_touch(n); return; }
+
+        bind_local(array.data() + array.size(), bytes);
+        auto slice_fn = [&array, n, slices, &init](size_t slice) { array.init_slice(n, slice, slices, init); };
+        run(slice_fn, slices);
+        array.end_first_touch(n);
+    }
+
+    // hint that the untouched pages in [address, address + bytes) go to whichever node touches them first
+    //     false when it did nothing (no libnuma, one node, or mbind refused), first touch still applies then
+    static bool bind_local(void* address, size_t bytes) noexcept
+    {
+    #if SBOFIRSTTOUCH_MBIND
+        if (numa_available() < 0 || numa_max_node() < 1) { return false; }
+
+        // only whole pages inside the block, the partial ones at the ends may be shared with other allocations
+        const uintptr_t page = uintptr_t(numa_pagesize());
+        const uintptr_t first = (uintptr_t(address) + page - 1) & ~(page - 1);
+        const uintptr_t last = (uintptr_t(address) + bytes) & ~(page - 1);
+        if (last <= first) { return false; }
+        return mbind(reinterpret_cast<void*>(first), last - first, MPOL_LOCAL, nullptr, 0, 0) == 0;
+    #else
+        (void)address; (void)bytes;
+        return false;
+    #endif
+    }
+
+    size_t parallel_bytes() const noexcept              { return parallel_bytes_; }
+
+//=====================================================================================================================
+// Underlying Data
+//=====================================================================================================================
+
+private:
+    size_t parallel_bytes_ = size_t(1) << 20;
+};
+
+#endif // SBOFIRSTTOUCH_H
@@ -0,0 +1,309 @@
+//=====================================================================================================================
+// MIT License
+//
+// Copyright (c) 2025 Cory Simonich
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//=====================================================================================================================
+
+//=====================================================================================================================
+//
+// SboGrid
+//
+//
+// dense 2d/3d grid on top of SboArray, small windows (local pathfinding, influence maps) stay in the inline buffer
+//     inline_cells is the SboArray size_threshold, count it in cells including tile padding
+//
+// layouts
+//     Linear  plain row major, row(y) is contiguous
+//     Tiled   the plane is cut into tile_size x tile_size tiles stored back to back, each tile is row major
+//             inside, a 3x3 stencil touches 1-4 tiles instead of 3 rows that are a full width apart
+//     Morton  same tiles, but cells inside a tile are in z-order, better when access is not row oriented
+//
+//     tiled layouts pad the extents up to a multiple of tile_size, depth slices are always stacked linearly
+//
+// bulk operations run over the raw storage (padding included) so they are straight loops the compiler can
+//     vectorize, the float blends have an explicit SSE path
+//
+// Example:
+//
+//      SboGrid<float, 1024, SboGridLayout::Tiled> influence(32, 32);
+//      influence.fill(0.0f);
+//      influence(4, 7) = 1.0f;
+//      influence.lerp(target, 0.25f);      // same extents + layout
+//
+//=====================================================================================================================
+
+
+#ifndef SBOGRID_H
+#define SBOGRID_H
+
+#include "sbo_array.h"
+
+#include <algorithm>    // fill_n, max
+#include <cstdint>      // uint32_t
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define SBOGRID_SSE 1
+#else
+    #define SBOGRID_SSE 0
+#endif
+
+enum class SboGridLayout
+{
+    Linear,
+    Tiled,
+    Morton,
+};
+
+template <typename T, size_t inline_cells = 256, SboGridLayout layout = SboGridLayout::Linear, uint32_t tile_size = 8>
+class SboGrid
+{
+    static_assert(tile_size > 0 && (tile_size & (tile_size - 1)) == 0, "SboGrid tile_size must be a power of two");
+    static_assert(tile_size <= 256, "SboGrid tile_size must fit the 16 bit morton code");
+
+//=====================================================================================================================
+// Public Api
+//=====================================================================================================================
+public:
+
+    // contiguous run of cells, a row (Linear) or a whole tile (Tiled/Morton)
+    template <typename U>
+    struct SpanView
+    {
+        U* first = nullptr;
+        size_t count = 0;
+
+        U* begin() const noexcept                       { return first; }
+        U* end() const noexcept                         { return first + count; }
+        U* data() const noexcept                        { return first; }
+        size_t size() const noexcept                    { return count; }
+        U& operator[](size_t i) const noexcept          { assert(i < count); return first[i]; }
+    };
+    using Span = SpanView<T>;
+    using ConstSpan = SpanView<const T>;
+
+    static constexpr bool tiled = layout != SboGridLayout::Linear;
+    static constexpr uint32_t tile_area = tile_size * tile_size;
+
+    SboGrid()                                           = default;
+    SboGrid(uint32_t width, uint32_t height, uint32_t depth = 1, const T& value = T()) { Resize(width, height, depth, value); }
+
+    void resize(uint32_t width, uint32_t height, uint32_t depth = 1, const T& value = T()) { Resize(width, height, depth, value); }
+
+    // query
+    uint32_t width() const noexcept                     { return width_; }
+    uint32_t height() const noexcept                    { return height_; }
+    uint32_t depth() const noexcept                     { return depth_; }
+    size_t cell_count() const noexcept                  { return size_t(width_) * height_ * depth_; }
+    size_t storage_size() const noexcept                { return cells_.size(); }
+    bool contains(int64_t x, int64_t y, int64_t z = 0) const noexcept { return x >= 0 && y >= 0 && z >= 0 && x < width_ && y < height_ && z < depth_; }
+    inline bool using_stack_buffer() const noexcept     { return cells_.using_stack_buffer(); }
+
+    // accessors
+    size_t index_of(uint32_t x, uint32_t y, uint32_t z = 0) const noexcept { return IndexOf(x, y, z); }
+    T& operator()(uint32_t x, uint32_t y, uint32_t z = 0) noexcept { return cells_[IndexOf(x, y, z)]; }
+    const T& operator()(uint32_t x, uint32_t y, uint32_t z = 0) const noexcept { return cells_[IndexOf(x, y, z)]; }
+    T* data() noexcept                                  { return cells_.data(); }
+    const T* data() const noexcept                      { return cells_.data(); }
+
+    // Linear only
+    Span row(uint32_t y, uint32_t z = 0) noexcept       { return { cells_.data() + RowStart(y, z), width_ }; }
+    ConstSpan row(uint32_t y, uint32_t z = 0) const noexcept { return { cells_.data() + RowStart(y, z), width_ }; }
+
+    // Tiled/Morton only, tx/ty in tiles, includes padding cells on the right/bottom edge
+    uint32_t tiles_x() const noexcept                   { return padded_width_ / tile_size; }
+    uint32_t tiles_y() const noexcept                   { return padded_height_ / tile_size; }
+    Span tile(uint32_t tx, uint32_t ty, uint32_t z = 0) noexcept { return { cells_.data() + TileStart(tx, ty, z), tile_area }; }
+    ConstSpan tile(uint32_t tx, uint32_t ty, uint32_t z = 0) const noexcept { return { cells_.data() + TileStart(tx, ty, z), tile_area }; }
+
+    // bulk, padding cells are written too so they never hold garbage, fill_rect covers [x0, x1) x [y0, y1)
+    void fill(const T& value)                           { std::fill_n(cells_.data(), cells_.size(), value); }
+    void fill_rect(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, const T& value, uint32_t z = 0) { FillRect(x0, y0, x1, y1, value, z); }
+
+    // element wise against a grid with the same extents and layout
+    //     lerp        this += (other - this) * t
+    //     add_scaled  this += other * s
+    //     max_with    this = max(this, other)
+    template <size_t N> void lerp(const SboGrid<T, N, layout, tile_size>& other, T t)       { Lerp(other.data(), other.storage_size(), t); }
+    template <size_t N> void add_scaled(const SboGrid<T, N, layout, tile_size>& other, T s) { AddScaled(other.data(), other.storage_size(), s); }
+    template <size_t N> void max_with(const SboGrid<T, N, layout, tile_size>& other)        { MaxWith(other.data(), other.storage_size()); }
+    void scale(T s)                                     { for (T& v : cells_) { v = v * s; } }
+
+//=====================================================================================================================
+// Underlying Data
+//=====================================================================================================================
+
+private:
+    SboArray<T, inline_cells> cells_;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    uint32_t depth_ = 0;
+    uint32_t padded_width_ = 0;
+    uint32_t padded_height_ = 0;
+    size_t slice_size_ = 0;
+
+//=====================================================================================================================
+// Implementation
+//=====================================================================================================================
+
+    static constexpr uint32_t RoundUp(uint32_t v) { return tiled ? (v + tile_size - 1) & ~(tile_size - 1) : v; }
+
+    // spreads the low 8 bits of v over the even bits
+    static constexpr uint32_t Part1By1(uint32_t v)
+    {
+        v &= 0xFF;
+        v = (v | (v << 4)) & 0x0F0F;
+        v = (v | (v << 2)) & 0x3333;
+        v = (v | (v << 1)) & 0x5555;
+        return v;
+    }
+
+    void Resize(uint32_t width, uint32_t height, uint32_t depth, const T& value)
+    {
+        width_ = width;
+        height_ = height;
+        depth_ = depth;
+        padded_width_ = RoundUp(width);
+        padded_height_ = RoundUp(height);
+        slice_size_ = size_t(padded_width_) * padded_height_;
+        cells_ = SboArray<T, inline_cells>(slice_size_ * depth_, value);
+    }
+
+    inline size_t IndexOf(uint32_t x, uint32_t y, uint32_t z) const noexcept
+    {
+        assert(x < width_ && y < height_ && z < depth_);
+        const size_t slice = z * slice_size_;
+        if_constexpr (layout == SboGridLayout::Linear)
+        {
+            return slice + size_t(y) * width_ + x;
+        }
+        else
+        {
+            const uint32_t tx = x / tile_size;
+            const uint32_t ty = y / tile_size;
+            const uint32_t lx = x & (tile_size - 1);
+            const uint32_t ly = y & (tile_size - 1);
+            const size_t tile_index = (size_t(ty) * (padded_width_ / tile_size) + tx) * tile_area;
+            if_constexpr (layout == SboGridLayout::Tiled) { return slice + tile_index + ly * tile_size + lx; }
+            else { return slice + tile_index + (Part1By1(lx) | (Part1By1(ly) << 1)); }
+        }
+    }
+
+    inline size_t RowStart(uint32_t y, uint32_t z) const noexcept
+    {
+        static_assert(layout == SboGridLayout::Linear, "SboGrid::row needs the Linear layout, use tile() for tiled grids");
+        assert(y < height_ && z < depth_);
+        return z * slice_size_ + size_t(y) * width_;
+    }
+
+    inline size_t TileStart(uint32_t tx, uint32_t ty, uint32_t z) const noexcept
+    {
+        static_assert(tiled, "SboGrid::tile needs a Tiled or Morton layout, use row() for linear grids");
+        assert(tx < tiles_x() && ty < tiles_y() && z < depth_);
+        return z * slice_size_ + (size_t(ty) * tiles_x() + tx) * tile_area;
+    }
+
+    void FillRect(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, const T& value, uint32_t z)
+    {
+        x1 = std::min(x1, width_);
+        y1 = std::min(y1, height_);
+        for (uint32_t y = y0; y < y1; ++y)
+        {
+            if_constexpr (layout == SboGridLayout::Linear)
+            {
+                if (x0 < x1) { std::fill_n(cells_.data() + IndexOf(x0, y, z), x1 - x0, value); }
+            }
+            else if_constexpr (layout == SboGridLayout::Tiled)
+            {
+                // contiguous within each tile row
+                for (uint32_t x = x0; x < x1;)
+                {
+                    const uint32_t run = std::min(x1 - x, tile_size - (x & (tile_size - 1)));
+                    std::fill_n(cells_.data() + IndexOf(x, y, z), run, value);
+                    x += run;
+                }
+            }
+            else
+            {
+                for (uint32_t x = x0; x < x1; ++x) { cells_[IndexOf(x, y, z)] = value; }
+            }
+        }
+    }
+
+    void Lerp(const T* src, size_t n, T t)
+    {
+        assert(n == cells_.size());
+        T* dst = cells_.data();
+        size_t i = 0;
+    #if SBOGRID_SSE
+        if_constexpr (std::is_same_v<T, float>)
+        {
+            const __m128 vt = _mm_set1_ps(t);
+            for (; i + 4 <= n; i += 4)
+            {
+                const __m128 d = _mm_loadu_ps(dst + i);
+                const __m128 s = _mm_loadu_ps(src + i);
+                _mm_storeu_ps(dst + i, _mm_add_ps(d, _mm_mul_ps(_mm_sub_ps(s, d), vt)));
+            }
+        }
+    #endif
+        for (; i < n; ++i) { dst[i] = dst[i] + (src[i] - dst[i]) * t; }
+    }
+
+    void AddScaled(const T* src, size_t n, T s)
+    {
+        assert(n == cells_.size());
+        T* dst = cells_.data();
+        size_t i = 0;
+    #if SBOGRID_SSE
+        if_constexpr (std::is_same_v<T, float>)
+        {
+            const __m128 vs = _mm_set1_ps(s);
+            for (; i + 4 <= n; i += 4)
+            {
+                _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), vs)));
+            }
+        }
+    #endif
+        for (; i < n; ++i) { dst[i] = dst[i] + src[i] * s; }
+    }
+
+    void MaxWith(const T* src, size_t n)
+    {
+        assert(n == cells_.size());
+        T* dst = cells_.data();
+        size_t i = 0;
+    #if SBOGRID_SSE
+        if_constexpr (std::is_same_v<T, float>)
+        {
+            // maxps returns its second operand when either is NaN, std::max(dst, src) below keeps dst, so dst goes second
+            for (; i + 4 <= n; i += 4)
+            {
+                _mm_storeu_ps(dst + i, _mm_max_ps(_mm_loadu_ps(src + i), _mm_loadu_ps(dst + i)));
+            }
+        }
+    #endif
+        for (; i < n; ++i) { dst[i] = std::max(dst[i], src[i]); }
+    }
+};
+
+#endif // SBOGRID_H
@@ -0,0 +1,196 @@
+//=====================================================================================================================
+// MIT License
+//
+// Copyright (c) 2025 Cory Simonich
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//=====================================================================================================================
+
+//=====================================================================================================================
+//
+// Heap Compactor
+//
+//
+// opt in registry of long lived SboArrays, compact_all() (load screens, level transitions) moves the heap buffer
+//     of every registered array into one contiguous arena, back to back in registration order
+//     after hours of play the spilled buffers are scattered all over the heap, afterwards walking the arrays
+//     in that order is a linear walk through memory and the old blocks go back to the allocator
+//
+//     every buffer is cut down to its size, arrays that fit their stack buffer again move back into it instead
+//
+// ownership
+//     an arena is shared by the compactor and the arrays borrowing a slice of it (SboArena counts them), it is
+//         freed when the last one lets go, no array ever frees a slice itself
+//     an array lets go of its slice the first time it grows or shrinks (the slice is just dead space until the
+//         arena goes), or when it is destroyed, a move hands the slice to the destination as is, O(1) and
+//         nothing allocated, registered or not the destination keeps the arena alive
+//     a registered array must be remove()d before it is destroyed, the compactor keeps a pointer to it
+//     compact_all() lets go of the previous arena, the destructor (or release_all) gives every registered array
+//         still in the arena its own block back first
+//     not thread safe, nothing else may touch the registered arrays during compact_all/release_all
+//
+// Example:
+//
+//      SboHeapCompactor compactor;
+//      compactor.add(world.entity_ids);
+//      compactor.add(world.nav_edges);
+//      ...
+//      void OnLoadScreen() { compactor.compact_all(); }
+//
+//=====================================================================================================================
+
+
+#ifndef SBOHEAPCOMPACTOR_H
+#define SBOHEAPCOMPACTOR_H
+
+#include "sbo_array.h"
+
+#include <new>          // operator new, nothrow
+
+class SboHeapCompactor
+{
+
+//=====================================================================================================================
+// Public Api
+//=====================================================================================================================
+public:
+    SboHeapCompactor()                                  = default;
+    SboHeapCompactor(const SboHeapCompactor&)           = delete;
+    SboHeapCompactor& operator=(const SboHeapCompactor&) = delete;
+    ~SboHeapCompactor()                                 { Destroy(); }
+
+    // registration, compact_all visits the arrays in the order they were added
+    template <typename T, size_t N>
+    void add(SboArray<T, N>& array)                     { Add(array); }
+    template <typename T, size_t N>
+    void remove(SboArray<T, N>& array) noexcept         { Remove(&array); }     // the array keeps its slice, if it has one
+
+    // false if the arena could not be allocated, nothing is moved in that case
+    bool compact_all() noexcept                         { return CompactAll(); }
+    // every registered array gets a block of its own and the compactor lets go of the arena, false if one of them
+    //     could not (it keeps its slice, and the arena lives on until it lets go)
+    bool release_all() noexcept                         { return ReleaseAll(); }
+
+    // query
+    size_t size() const noexcept                        { return entries_.size(); }
+    size_t arena_bytes() const noexcept                 { return arena_bytes_; }
+
+//=====================================================================================================================
+// Underlying Data
+//=====================================================================================================================
+
+private:
+    struct Entry
+    {
+        void* array;
+        size_t (*bytes)(const void* array);
+        void (*compact_into)(void* array, void* dest);
+        bool (*detach)(void* array);
+    };
+
+    static constexpr size_t align_ = SboArena::align;
+
+    SboArray<Entry, 32> entries_;
+    SboArena* arena_ = nullptr;
+    size_t arena_bytes_ = 0;
+
+//=====================================================================================================================
+// Implementation
+//=====================================================================================================================
+
+    static constexpr size_t AlignUp(size_t n) noexcept  { return (n + align_ - 1) & ~(align_ - 1); }
+
+    template <typename T, size_t N>
+    void Add(SboArray<T, N>& array)
+    {
+        static_assert(alignof(T) <= align_, "SboHeapCompactor only packs types up to max_align_t alignment");
+        using Array = SboArray<T, N>;
+        entries_.push_back(
+        {
+            &array,
+            [](const void* a) { return static_cast<const Array*>(a)->CompactBytes(); },
+            [](void* a, void* dest) { static_cast<Array*>(a)->CompactInto(static_cast<T*>(dest)); },
+            [](void* a) { return static_cast<Array*>(a)->DetachFromArena(); },
+        });
+    }
+
+    void Remove(void* array) noexcept
+    {
+        for (size_t i = 0; i < entries_.size(); ++i)
+        {
+            if (entries_[i].array != array) { continue; }
+            entries_.erase(entries_.begin() + i);
+            return;
+        }
+    }
+
+    // the arena is the SboArena header, then every slice behind a pointer back to it
+    bool CompactAll() noexcept
+    {
+        size_t total = 0;
+        size_t slices = 0;
+        for (const Entry& e : entries_)
+        {
+            const size_t bytes = e.bytes(e.array);
+            if (bytes) { total += align_ + AlignUp(bytes); ++slices; }
+        }
+
+        SboArena* arena = nullptr;
+        if (slices != 0)
+        {
+            total += align_;
+            void* block = ::operator new(total, std::nothrow);
+            if (!block) { return false; }
+            arena = new (block) SboArena{ { slices + 1 } };
+        }
+
+        // arrays in the previous arena move out of it like any other, letting go of their slices as they do
+        char* write = reinterpret_cast<char*>(arena) + align_;
+        for (const Entry& e : entries_)
+        {
+            const size_t bytes = e.bytes(e.array);
+            if (!bytes) { e.compact_into(e.array, nullptr); continue; }
+            *reinterpret_cast<SboArena**>(write) = arena;
+            e.compact_into(e.array, write + align_);
+            write += align_ + AlignUp(bytes);
+        }
+
+        if (arena_) { arena_->Drop(); }
+        arena_ = arena;
+        arena_bytes_ = total;
+        return true;
+    }
+
+    bool ReleaseAll() noexcept
+    {
+        if (!arena_) { return true; }
+        bool released = true;
+        for (const Entry& e : entries_) { released &= e.detach(e.array); }
+        arena_->Drop();
+        arena_ = nullptr;
+        arena_bytes_ = 0;
+        return released;
+    }
+
+    // an array that can not get its own block just keeps borrowing its slice
+    void Destroy() noexcept                             { ReleaseAll(); }
+};
+
+#endif // SBOHEAPCOMPACTOR_H
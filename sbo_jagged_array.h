@@ -0,0 +1,229 @@
+//=====================================================================================================================
+// MIT License
+//
+// Copyright (c) 2025 Cory Simonich
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//=====================================================================================================================
+
+//=====================================================================================================================
+//
+// Jagged Array (compressed sparse row)
+//
+//
+// replacement for SboArray<SboArray<T, N>> when the data is read mostly
+//     every inner SboArray carries its own full stack buffer + header, and the ones that spill end up all over
+//     the heap, here every row lives back to back in one values array and one offsets array says where
+//
+//     offsets_ has row_count() + 1 entries, row r is values_[offsets_[r], offsets_[r + 1])
+//
+// two ways to fill it
+//
+//     bulk, a counting pass then a fill pass, values are written exactly once into their final spot
+//
+//          SboJaggedArray<u32> adjacency;
+//          adjacency.begin_counts(node_count);
+//          for (edge : edges) { adjacency.count(edge.from); }
+//          adjacency.end_counts();
+//          for (edge : edges) { adjacency.fill(edge.from, edge.to); }
+//
+//     incremental, rows are appended at the end
+//
+//          adjacency.add_row();
+//          adjacency.push_back(neighbor);      // goes into the last row
+//          adjacency.append_row({ a, b, c });
+//
+// size_threshold is the inline capacity for values, row_threshold the inline capacity for rows
+//
+// rows are handed out as a Row view (pointer + size), contiguous, invalidated by anything that grows the array
+//
+//=====================================================================================================================
+
+
+#ifndef SBOJAGGEDARRAY_H
+#define SBOJAGGEDARRAY_H
+
+#include "sbo_array.h"
+
+#include <cstdint>      // uint32_t
+
+template <typename T, size_t size_threshold = 64, size_t row_threshold = 16>
+class SboJaggedArray
+{
+
+//=====================================================================================================================
+// Public Api
+//=====================================================================================================================
+public:
+
+    // contiguous view of a single row
+    template <typename U>
+    struct RowView
+    {
+        U* first = nullptr;
+        size_t count = 0;
+
+        U* begin() const noexcept                       { return first; }
+        U* end() const noexcept                         { return first + count; }
+        U* data() const noexcept                        { return first; }
+        size_t size() const noexcept                    { return count; }
+        bool empty() const noexcept                     { return count == 0; }
+        U& operator[](size_t i) const noexcept          { assert(i < count); return first[i]; }
+    };
+    using Row = RowView<T>;
+    using ConstRow = RowView<const T>;
+
+    SboJaggedArray()                                    { offsets_.push_back(0); }
+
+    // bulk build
+    void begin_counts(size_t row_count)                 { BeginCounts(row_count); }
+    void count(size_t row, uint32_t n = 1) noexcept     { assert(building_); offsets_[row + 1] += n; }
+    void end_counts()                                   { EndCounts(); }
+    void fill(size_t row, const T& value)               { Fill(row, value); }
+    void fill(size_t row, T&& value)                    { Fill(row, std::move(value)); }
+
+    // claims the next n slots of a row in one go, for callers that fill rows in blocks or from several threads
+    T* fill_span(size_t row, uint32_t n) noexcept       { return FillSpan(row, n); }
+
+    // builds from (row, value) pairs, e.g. std::pair<uint32_t, T>, in two passes over [first, last)
+    template <typename ForwardIt>
+    void assign_pairs(size_t row_count, ForwardIt first, ForwardIt last) { AssignPairs(row_count, first, last); }
+
+    // flattens an SboArray<SboArray<T, N>> style container
+    template <typename Nested>
+    void assign_nested(const Nested& nested)            { AssignNested(nested); }
+
+    // incremental
+    size_t add_row()                                    { offsets_.push_back(offsets_.back()); return row_count() - 1; }
+    void push_back(const T& value)                      { assert(row_count() > 0); values_.push_back(value); ++offsets_.back(); }
+    void push_back(T&& value)                           { assert(row_count() > 0); values_.push_back(std::move(value)); ++offsets_.back(); }
+    template <typename InputIt>
+    size_t append_row(InputIt first, InputIt last)      { return AppendRow(first, last); }
+    size_t append_row(std::initializer_list<T> init)    { return AppendRow(init.begin(), init.end()); }
+
+    void reserve(size_t rows, size_t values)            { offsets_.reserve(rows + 1); values_.reserve(values); }
+    void clear() noexcept                               { values_.clear(); offsets_.clear(); offsets_.push_back(0); }
+
+    // query
+    bool empty() const noexcept                         { return row_count() == 0; }
+    size_t row_count() const noexcept                   { return offsets_.size() - 1; }
+    size_t size() const noexcept                        { return values_.size(); }
+    size_t row_size(size_t row) const noexcept          { assert(row < row_count()); return offsets_[row + 1] - offsets_[row]; }
+    inline bool using_stack_buffer() const noexcept     { return values_.using_stack_buffer() && offsets_.using_stack_buffer(); }
+
+    // accessors
+    Row row(size_t r) noexcept                          { assert(r < row_count()); return { values_.data() + offsets_[r], row_size(r) }; }
+    ConstRow row(size_t r) const noexcept               { assert(r < row_count()); return { values_.data() + offsets_[r], row_size(r) }; }
+    Row operator[](size_t r) noexcept                   { return row(r); }
+    ConstRow operator[](size_t r) const noexcept        { return row(r); }
+
+    // raw csr arrays, for code that wants to walk every value at once
+    T* values() noexcept                                { return values_.data(); }
+    const T* values() const noexcept                    { return values_.data(); }
+    const uint32_t* offsets() const noexcept            { return offsets_.data(); }
+
+//=====================================================================================================================
+// Underlying Data
+//=====================================================================================================================
+
+private:
+    SboArray<T, size_threshold> values_;
+    SboArray<uint32_t, row_threshold + 1> offsets_;
+    bool building_ = false;
+
+//=====================================================================================================================
+// Implementation
+//=====================================================================================================================
+
+    inline void BeginCounts(size_t row_count)
+    {
+        values_.clear();
+        offsets_ = SboArray<uint32_t, row_threshold + 1>(row_count + 1, 0u);
+        building_ = true;
+    }
+
+    // exclusive scan shifted up by one, offsets_[r + 1] becomes the start of row r and is used as its write
+    //     cursor during the fill pass, after every row is filled it has walked to the end of row r, which is
+    //     exactly the start of row r + 1
+    inline void EndCounts()
+    {
+        assert(building_);
+        uint32_t sum = 0;
+        for (size_t r = 1; r < offsets_.size(); ++r)
+        {
+            const uint32_t c = offsets_[r];
+            offsets_[r] = sum;
+            sum += c;
+        }
+
+        // sized in one go so the fill pass can assign out of order, pod values are left uninitialized
+        values_ = SboArray<T, size_threshold>(sum);
+        building_ = false;
+    }
+
+    template <typename Arg>
+    inline void Fill(size_t row, Arg&& value)
+    {
+        assert(!building_ && row < row_count());
+        uint32_t& cursor = offsets_[row + 1];
+        assert(cursor < values_.size());
+        values_[cursor++] = std::forward<Arg>(value);
+    }
+
+    inline T* FillSpan(size_t row, uint32_t n) noexcept
+    {
+        assert(!building_ && row < row_count());
+        uint32_t& cursor = offsets_[row + 1];
+        assert(cursor + n <= values_.size());
+        T* first = values_.data() + cursor;
+        cursor += n;
+        return first;
+    }
+
+    template <typename ForwardIt>
+    void AssignPairs(size_t row_count, ForwardIt first, ForwardIt last)
+    {
+        BeginCounts(row_count);
+        for (ForwardIt it = first; it != last; ++it) { count(size_t(it->first)); }
+        EndCounts();
+        for (ForwardIt it = first; it != last; ++it) { Fill(size_t(it->first), it->second); }
+    }
+
+    template <typename Nested>
+    void AssignNested(const Nested& nested)
+    {
+        size_t total = 0;
+        for (const auto& inner : nested) { total += inner.size(); }
+
+        clear();
+        reserve(nested.size(), total);
+        for (const auto& inner : nested) { AppendRow(inner.begin(), inner.end()); }
+    }
+
+    template <typename InputIt>
+    inline size_t AppendRow(InputIt first, InputIt last)
+    {
+        const size_t r = add_row();
+        for (; first != last; ++first) { push_back(*first); }
+        return r;
+    }
+};
+
+#endif // SBOJAGGEDARRAY_H
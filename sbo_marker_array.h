@@ -0,0 +1,130 @@
+//=====================================================================================================================
+// MIT License
+//
+// Copyright (c) 2025 Cory Simonich
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//=====================================================================================================================
+
+//=====================================================================================================================
+//
+// Generation Stamped Marker Array
+//
+//
+// a "visited" set sized to the node count that clears in O(1)
+//     every slot holds the generation it was last marked in, a slot is marked iff its stamp == generation_
+//     clear() just bumps generation_, the stamps only get wiped when the counter wraps around
+//     stamp 0 is never a live generation, so freshly zeroed storage reads as unmarked
+//
+// the Stamp type trades memory for how often the full wipe happens
+//     uint8_t  wipes every 255 clears
+//     uint16_t wipes every 65535 clears
+//     uint32_t (default) effectively never
+//
+// Example:
+//
+//      SboMarkerArray<> visited(map.node_count());
+//      for (each search)
+//      {
+//          visited.clear(); // O(1), not O(map size)
+//          ...
+//          if (visited.test_and_set(node)) { continue; } // already seen this search
+//      }
+//
+//=====================================================================================================================
+
+
+#ifndef SBOMARKERARRAY_H
+#define SBOMARKERARRAY_H
+
+#include "sbo_array.h"
+
+#include <algorithm>    // fill
+#include <cstdint>      // uint32_t
+#include <limits>       // numeric_limits
+
+template <size_t size_threshold = 64, typename Stamp = uint32_t>
+class SboMarkerArray
+{
+    static_assert(std::is_unsigned_v<Stamp>, "SboMarkerArray requires an unsigned Stamp type");
+
+//=====================================================================================================================
+// Public Api
+//=====================================================================================================================
+public:
+    SboMarkerArray()                                    = default;
+    explicit SboMarkerArray(size_t size)                { Resize(size); }
+
+    // resize drops every mark
+    void resize(size_t size)                            { Resize(size); }
+    void clear() noexcept                               { Clear(); }
+
+    bool test(size_t i) const noexcept                  { assert(i < size()); return stamps_[i] == generation_; }
+    void set(size_t i) noexcept                         { assert(i < size()); stamps_[i] = generation_; }
+    void reset(size_t i) noexcept                       { assert(i < size()); stamps_[i] = 0; }
+
+    // returns the previous state, the store is unconditional so there is no branch on the hot path
+    bool test_and_set(size_t i) noexcept                { return TestAndSet(i); }
+
+    size_t size() const noexcept                        { return stamps_.size(); }
+    Stamp generation() const noexcept                   { return generation_; }
+    inline bool using_stack_buffer() const noexcept     { return stamps_.using_stack_buffer(); }
+
+//=====================================================================================================================
+// Underlying Data
+//=====================================================================================================================
+
+private:
+    SboArray<Stamp, size_threshold> stamps_;
+    Stamp generation_ = 1;
+
+//=====================================================================================================================
+// Implementation
+//=====================================================================================================================
+
+    inline void Resize(size_t size)
+    {
+        stamps_ = SboArray<Stamp, size_threshold>(size, Stamp(0));
+        generation_ = 1;
+    }
+
+    inline void Clear() noexcept
+    {
+        // the rare full wipe, after wraparound old stamps would read as marked again
+        if (generation_ == std::numeric_limits<Stamp>::max())
+        {
+            std::fill(stamps_.begin(), stamps_.end(), Stamp(0));
+            generation_ = 1;
+            return;
+        }
+        ++generation_;
+    }
+
+    inline bool TestAndSet(size_t i) noexcept
+    {
+        assert(i < size());
+        Stamp& stamp = stamps_[i];
+        const bool was_set = (stamp == generation_);
+        stamp = generation_;
+        return was_set;
+    }
+};
+
+#endif // SBOMARKERARRAY_H
@@ -0,0 +1,274 @@
+//=====================================================================================================================
+// MIT License
+//
+// Copyright (c) 2025 Cory Simonich
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//=====================================================================================================================
+
+//=====================================================================================================================
+//
+// Partitioner
+//
+//
+// splits one array into several by key (entities by team, by lod bucket, ...) without push_back growth cascades
+//     counting pass, every key is computed once and counted per bucket
+//     every output grows exactly once, to its final size
+//     scatter pass, every element is written once into its final spot, order inside a bucket is preserved
+//
+// outputs are SboArrays (appended to, not cleared) or an SboJaggedArray (rebuilt, one row per bucket)
+//
+// the partitioner owns the key and histogram scratch, keep one around and per frame calls stop allocating
+//
+// inputs of at least parallel_threshold elements are split into thread_count chunks that count and scatter on
+//     their own threads, every chunk gets a private slice of every bucket so the result is identical to the
+//     serial one, keyfn/pred must be safe to call concurrently
+//     SboArray outputs of non pod types always scatter serially (push_back into reserved capacity)
+//
+// Example:
+//
+//      SboPartitioner<> partitioner(std::thread::hardware_concurrency());
+//
+//      SboArray<Entity, 256> alive, dead;
+//      partitioner.partition_into(entities, [](const Entity& e) { return e.hp > 0; }, alive, dead);
+//
+//      SboJaggedArray<Entity> by_lod;
+//      partitioner.group_by_key(entities, [](const Entity& e) { return e.lod; }, lod_count, by_lod);
+//      for (Entity& e : by_lod[0]) { ... }
+//
+//=====================================================================================================================
+
+
+#ifndef SBOPARTITION_H
+#define SBOPARTITION_H
+
+#include "sbo_array.h"
+#include "sbo_jagged_array.h"
+
+#include <algorithm>    // min
+#include <cstdint>      // uint32_t
+#include <thread>       // thread
+#include <type_traits>  // decay_t
+#include <utility>      // forward
+
+template <size_t size_threshold = 256>
+class SboPartitioner
+{
+
+//=====================================================================================================================
+// Public Api
+//=====================================================================================================================
+public:
+    explicit SboPartitioner(unsigned thread_count = 1, size_t parallel_threshold = 1 << 16)
+                                                        { set_threading(thread_count, parallel_threshold); }
+    void set_threading(unsigned thread_count, size_t parallel_threshold) noexcept
+                                                        { thread_count_ = thread_count ? thread_count : 1; parallel_threshold_ = parallel_threshold; }
+
+    // pred(x) true goes to out_true, false to out_false
+    template <typename Source, typename Pred, typename Out>
+    void partition_into(const Source& source, Pred&& pred, Out& out_true, Out& out_false)
+    {
+        Out* outs[2] = { &out_true, &out_false };
+        GroupInto(source, [&pred](const auto& x) { return pred(x) ? 0u : 1u; }, 2, [&outs](size_t k) -> Out& { return *outs[k]; });
+    }
+
+    // keyfn(x) in [0, bucket_count) picks the output, outputs[k] is an SboArray
+    template <typename Source, typename KeyFn, typename Outs>
+    void group_by_key(const Source& source, KeyFn&& keyfn, size_t bucket_count, Outs& outputs)
+    {
+        GroupInto(source, keyfn, bucket_count, [&outputs](size_t k) -> auto& { return outputs[k]; });
+    }
+
+    // csr result, row k of out is bucket k
+    template <typename Source, typename KeyFn, typename T, size_t N, size_t R>
+    void group_by_key(const Source& source, KeyFn&& keyfn, size_t bucket_count, SboJaggedArray<T, N, R>& out)
+    {
+        GroupIntoJagged(source, keyfn, bucket_count, out);
+    }
+
+    // query, bucket sizes of the last call
+    size_t bucket_count() const noexcept                { return totals_.size(); }
+    uint32_t bucket_size(size_t k) const noexcept       { return totals_[k]; }
+    unsigned thread_count() const noexcept              { return thread_count_; }
+    inline bool using_stack_buffer() const noexcept     { return keys_.using_stack_buffer() && offsets_.using_stack_buffer() && totals_.using_stack_buffer(); }
+
+//=====================================================================================================================
+// Underlying Data
+//=====================================================================================================================
+
+private:
+    SboArray<uint32_t, size_threshold> keys_;   // key per element, computed once in the counting pass
+    SboArray<uint32_t, 64> offsets_;            // [chunk * bucket_count + k], counts then per chunk write offsets
+    SboArray<uint32_t, 16> totals_;             // elements per bucket
+    size_t parallel_threshold_ = 1 << 16;
+    unsigned thread_count_ = 1;
+
+//=====================================================================================================================
+// Implementation
+//=====================================================================================================================
+
+    // fn(chunk, begin, end) on `chunks` even slices of [0, n), chunk 0 runs on the calling thread
+    //     a chunk whose thread could not be started (std::system_error) runs on the calling thread as well, the
+    //     started workers are joined on every way out, a joinable std::thread going away is std::terminate
+    template <typename F>
+    static void ForEachChunk(size_t n, size_t chunks, F&& fn)
+    {
+        if (chunks == 1) { fn(size_t(0), size_t(0), n); return; }
+
+        struct Workers
+        {
+            SboArray<std::thread, 16> threads;
+            ~Workers() { for (std::thread& worker : threads) { worker.join(); } }
+        } workers;
+        workers.threads.reserve(chunks - 1);    // before any thread is started, emplace_back below never allocates
+
+        const size_t step = (n + chunks - 1) / chunks;
+        size_t c = 1;
+        for (; c < chunks; ++c)
+        {
+            const size_t begin = std::min(n, c * step);
+            const size_t end = std::min(n, begin + step);
+            if (!Spawn(workers.threads, [&fn, c, begin, end]() { fn(c, begin, end); })) { break; }
+        }
+        fn(size_t(0), size_t(0), std::min(n, step));
+        for (; c < chunks; ++c) { fn(c, std::min(n, c * step), std::min(n, c * step + step)); }
+    }
+
+    // false when the thread could not be started, without exceptions the standard library aborts on that instead
+    template <typename Job>
+    static bool Spawn(SboArray<std::thread, 16>& threads, Job&& job) noexcept
+    {
+    #ifndef SBOARRAY_NO_EXCEPTIONS
+        try { threads.emplace_back(std::forward<Job>(job)); }
+        catch (...) { return false; }
+    #else
+        threads.emplace_back(std::forward<Job>(job));
+    #endif
+        return true;
+    }
+
+    inline size_t ChunksFor(size_t n) const noexcept
+    {
+        return (n >= parallel_threshold_ && thread_count_ > 1) ? thread_count_ : 1;
+    }
+
+    // counting pass, leaves keys_, totals_ and offsets_ (exclusive offset of every chunk inside every bucket)
+    template <typename Source, typename KeyFn>
+    void Count(const Source& source, KeyFn& keyfn, size_t bucket_count, size_t chunks)
+    {
+        const size_t n = source.size();
+        const auto* src = source.data();
+        keys_.resize_and_overwrite(n, [n](uint32_t*, size_t) { return n; });
+        offsets_ = SboArray<uint32_t, 64>(chunks * bucket_count, 0u);
+
+        uint32_t* keys = keys_.data();
+        ForEachChunk(n, chunks, [&](size_t chunk, size_t begin, size_t end)
+        {
+            uint32_t* counts = offsets_.data() + chunk * bucket_count;
+            for (size_t i = begin; i < end; ++i)
+            {
+                const uint32_t k = uint32_t(keyfn(src[i]));
+                assert(k < bucket_count);
+                keys[i] = k;
+                ++counts[k];
+            }
+        });
+
+        totals_ = SboArray<uint32_t, 16>(bucket_count, 0u);
+        for (size_t k = 0; k < bucket_count; ++k)
+        {
+            for (size_t chunk = 0; chunk < chunks; ++chunk)
+            {
+                uint32_t& slot = offsets_[chunk * bucket_count + k];
+                const uint32_t c = slot;
+                slot = totals_[k];
+                totals_[k] += c;
+            }
+        }
+    }
+
+    // scatter pass, bases[k] points at the first slot of bucket k, the slots may be uninitialized pod storage
+    template <typename Source, typename Dest>
+    void Scatter(const Source& source, Dest* const* bases, size_t bucket_count, size_t chunks)
+    {
+        const auto* src = source.data();
+        const uint32_t* keys = keys_.data();
+        ForEachChunk(source.size(), chunks, [&](size_t chunk, size_t begin, size_t end)
+        {
+            uint32_t* cursor = offsets_.data() + chunk * bucket_count;
+            for (size_t i = begin; i < end; ++i)
+            {
+                const uint32_t k = keys[i];
+                bases[k][cursor[k]++] = src[i];
+            }
+        });
+    }
+
+    template <typename Source, typename KeyFn, typename OutAt>
+    void GroupInto(const Source& source, KeyFn&& keyfn, size_t bucket_count, OutAt out_at)
+    {
+        using Out = std::decay_t<decltype(out_at(0))>;
+        using Dest = typename Out::value_type;
+        constexpr bool pod = std::is_trivially_copyable_v<Dest> && std::is_trivially_default_constructible_v<Dest>;
+
+        // non pod outputs can not be written out of order into raw capacity, they push_back serially instead
+        const size_t chunks = pod ? ChunksFor(source.size()) : 1;
+        Count(source, keyfn, bucket_count, chunks);
+
+        if_constexpr (pod)
+        {
+            SboArray<Dest*, 16> bases(bucket_count);
+            for (size_t k = 0; k < bucket_count; ++k)
+            {
+                Out& out = out_at(k);
+                const size_t old_size = out.size();
+                const size_t new_size = old_size + totals_[k];
+                out.resize_and_overwrite(new_size, [&](Dest* p, size_t) { bases[k] = p + old_size; return new_size; });
+            }
+            Scatter(source, bases.data(), bucket_count, chunks);
+        }
+        else
+        {
+            for (size_t k = 0; k < bucket_count; ++k) { Out& out = out_at(k); out.reserve(out.size() + totals_[k]); }
+
+            const auto* src = source.data();
+            for (size_t i = 0; i < source.size(); ++i) { out_at(keys_[i]).push_back(src[i]); }
+        }
+    }
+
+    // the jagged array sizes its values in end_counts, so every slot is already constructed and any T can be
+    //     scattered from several threads
+    template <typename Source, typename KeyFn, typename T, size_t N, size_t R>
+    void GroupIntoJagged(const Source& source, KeyFn& keyfn, size_t bucket_count, SboJaggedArray<T, N, R>& out)
+    {
+        const size_t chunks = ChunksFor(source.size());
+        Count(source, keyfn, bucket_count, chunks);
+
+        out.begin_counts(bucket_count);
+        for (size_t k = 0; k < bucket_count; ++k) { out.count(k, totals_[k]); }
+        out.end_counts();
+
+        SboArray<T*, 16> bases(bucket_count);
+        for (size_t k = 0; k < bucket_count; ++k) { bases[k] = out.fill_span(k, totals_[k]); }
+        Scatter(source, bases.data(), bucket_count, chunks);
+    }
+};
+
+#endif // SBOPARTITION_H
@@ -0,0 +1,537 @@
+//=====================================================================================================================
+// MIT License
+//
+// Copyright (c) 2025 Cory Simonich
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//=====================================================================================================================
+
+//=====================================================================================================================
+//
+// SboArray Pathfinding
+//
+//
+// reference A* built entirely on SboArray, this is the "pathfinding for shorter paths stays on the stack" claim
+// made concrete so it can be measured (see sbo_pathfinding_bench.cpp)
+//
+//     SboPriorityQueue   binary min heap over an SboArray, the default open list
+//     SboBucketQueue     Dial style bucket queue for small integer keys, buckets are SboArrays
+//     SboGridMap         uniform cost grid, 4 or 8 connected, cell cost 0 == blocked
+//     SboAStar           the search, open list + closed set + node records are all SboArrays
+//
+// the closed set is a small open addressing table (node id -> record index) instead of a dense array sized
+//     to the map, so a short search only ever touches memory proportional to the nodes it expanded
+//     its occupancy is an SboMarkerArray, so a reused searcher starts every search with an O(1) clear
+//
+// any graph can be searched as long as it provides
+//
+//      uint32_t node_count() const;
+//      uint32_t heuristic(uint32_t from, uint32_t to) const;              // must be admissible
+//      template <typename F> void for_each_neighbor(uint32_t node, F&& fn) const;   // fn(neighbor, edge_cost)
+//
+// Example:
+//
+//      SboGridMap map(64, 64);
+//      map.set_cost(10, 10, 0); // wall
+//
+//      SboArray<uint32_t, 64> path;
+//      SboAStar<SboGridMap> astar;
+//      if (astar.find_path(map, map.node(0, 0), map.node(63, 63), path)) { ... }
+//
+//      // integer costs + consistent heuristic, swap the heap for buckets
+//      SboAStar<SboGridMap, 64, SboBucketOpenList> bucket_astar;
+//
+//=====================================================================================================================
+
+
+#ifndef SBOPATHFINDING_H
+#define SBOPATHFINDING_H
+
+#include "sbo_array.h"
+#include "sbo_marker_array.h"
+
+#include <algorithm>    // push_heap, pop_heap, reverse
+#include <cstdint>      // uint32_t
+#include <functional>   // std::less
+
+//=====================================================================================================================
+// Priority Queue
+//=====================================================================================================================
+
+// min heap, top() is the smallest element according to Compare
+template <typename T, size_t size_threshold = 64, typename Compare = std::less<T>>
+class SboPriorityQueue
+{
+public:
+    void push(const T& value)                           { Push(value); }
+    void pop() noexcept                                 { Pop(); }
+    T pop_min() noexcept                                { T value = top(); Pop(); return value; }
+    const T& top() const noexcept                       { assert(!empty()); return heap_.front(); }
+    void clear() noexcept                               { heap_.clear(); }
+    void reserve(size_t new_cap)                        { heap_.reserve(new_cap); }
+
+    bool empty() const noexcept                         { return heap_.empty(); }
+    size_t size() const noexcept                        { return heap_.size(); }
+    inline bool using_stack_buffer() const noexcept     { return heap_.using_stack_buffer(); }
+
+private:
+    // std heap algorithms build a max heap, flip the comparison to keep the smallest on top
+    struct Greater { bool operator()(const T& a, const T& b) const { return Compare()(b, a); } };
+
+    inline void Push(const T& value) { heap_.push_back(value); std::push_heap(heap_.begin(), heap_.end(), Greater()); }
+    inline void Pop() noexcept { assert(!empty()); std::pop_heap(heap_.begin(), heap_.end(), Greater()); heap_.pop_back(); }
+
+    SboArray<T, size_threshold> heap_;
+};
+
+//=====================================================================================================================
+// Bucket Queue
+//=====================================================================================================================
+
+// Dial style monotone priority queue for small integer keys
+//     a ring of buckets indexed by key, every live key is in [min_key(), min_key() + bucket_count())
+//     push and pop_min are O(1) plus the walk over empty buckets, no comparisons at all
+//     keys must never go below the last popped key (true for Dijkstra, and for A* with a consistent heuristic),
+//     a smaller key is clamped to the last popped key rather than lost
+//     a key past the end of the ring grows the ring, so max_key_span is a hint, not a limit
+//
+// buckets are SboArrays with a small inline capacity and are never shrunk, clear() keeps every bucket's capacity
+//     so a queue that lives across searches stops allocating once it has seen its worst case
+//
+// values with the same key pop in LIFO order
+template <typename T, size_t bucket_threshold = 8>
+class SboBucketQueue
+{
+public:
+    explicit SboBucketQueue(uint32_t max_key_span = 63)  { Rebuild(max_key_span + 1); }
+
+    void push(uint32_t key, const T& value)             { Push(key, value); }
+    T pop_min() noexcept                                { return PopMin(); }
+    uint32_t min_key() noexcept                         { assert(!empty()); Advance(); return cursor_; }
+    void clear() noexcept                               { Clear(); }
+
+    // every value shares the same key
+    template <typename InputIt>
+    void push_batch(uint32_t key, InputIt first, InputIt last) { PushBatch(key, first, last); }
+
+    // appends every value holding the minimum key to out and returns that key
+    template <typename Out>
+    uint32_t pop_min_batch(Out& out)                    { return PopMinBatch(out); }
+
+    bool empty() const noexcept                         { return count_ == 0; }
+    size_t size() const noexcept                        { return count_; }
+    size_t bucket_count() const noexcept                { return buckets_.size(); }
+    bool using_stack_buffer() const noexcept            { return UsingStackBuffer(); }
+
+//=====================================================================================================================
+// Underlying Data
+//=====================================================================================================================
+
+private:
+    using Bucket = SboArray<T, bucket_threshold>;
+
+    SboArray<Bucket, 64> buckets_;  // size is always a power of two
+    size_t mask_ = 0;
+    size_t count_ = 0;
+    uint32_t cursor_ = 0;           // key of the first ring slot, == min key after Advance()
+    uint32_t last_popped_ = 0;      // monotone floor, no key below this can be pushed
+    uint32_t max_key_ = 0;          // upper bound on every live key
+
+//=====================================================================================================================
+// Implementation
+//=====================================================================================================================
+
+    static size_t NextPowerOfTwo(size_t n) { size_t p = 1; while (p < n) { p <<= 1; } return p; }
+
+    inline Bucket& BucketFor(uint32_t& key)
+    {
+        if (key < last_popped_) { key = last_popped_; }
+        if (count_ == 0) { cursor_ = key; max_key_ = key; }
+
+        // below the ring start but still legal, slide the ring down if the live keys still fit
+        if (key < cursor_)
+        {
+            if (size_t(max_key_ - key) <= mask_) { cursor_ = key; }
+            else { Regrow(key, size_t(max_key_ - key) + 1); }
+        }
+        else if (size_t(key - cursor_) > mask_) { Regrow(cursor_, size_t(key - cursor_) + 1); }
+
+        max_key_ = std::max(max_key_, key);
+        return buckets_[key & mask_];
+    }
+
+    inline void Push(uint32_t key, const T& value)
+    {
+        BucketFor(key).push_back(value);
+        ++count_;
+    }
+
+    template <typename InputIt>
+    inline void PushBatch(uint32_t key, InputIt first, InputIt last)
+    {
+        if (first == last) { return; }
+        Bucket& bucket = BucketFor(key);
+        const size_t before = bucket.size();
+        bucket.insert(bucket.end(), first, last);
+        count_ += bucket.size() - before;
+    }
+
+    // walk the cursor up to the first non empty bucket, only valid while count_ > 0
+    inline void Advance() noexcept
+    {
+        while (buckets_[cursor_ & mask_].empty()) { ++cursor_; }
+    }
+
+    inline T PopMin() noexcept
+    {
+        assert(!empty());
+        Advance();
+        Bucket& bucket = buckets_[cursor_ & mask_];
+        T value = std::move(bucket.back());
+        bucket.pop_back();
+        --count_;
+        last_popped_ = cursor_;
+        return value;
+    }
+
+    template <typename Out>
+    inline uint32_t PopMinBatch(Out& out)
+    {
+        assert(!empty());
+        Advance();
+        Bucket& bucket = buckets_[cursor_ & mask_];
+        for (T& value : bucket) { out.push_back(std::move(value)); }
+        count_ -= bucket.size();
+        bucket.clear();
+        last_popped_ = cursor_;
+        return cursor_;
+    }
+
+    inline void Clear() noexcept
+    {
+        if (count_ != 0) { for (Bucket& bucket : buckets_) { bucket.clear(); } }
+        count_ = 0;
+        cursor_ = 0;
+        last_popped_ = 0;
+        max_key_ = 0;
+    }
+
+    void Rebuild(size_t span)
+    {
+        const size_t n = NextPowerOfTwo(span);
+        buckets_ = SboArray<Bucket, 64>(n);
+        mask_ = n - 1;
+    }
+
+    // rare, only when a key lands outside the ring, every bucket keeps its key but moves to its slot in the new ring
+    //     which starts at new_base and covers at least span keys
+    void Regrow(uint32_t new_base, size_t span)
+    {
+        SboArray<Bucket, 64> old = std::move(buckets_);
+        const size_t old_mask = mask_;
+        const uint32_t old_base = cursor_;
+        Rebuild(span);
+        for (size_t i = 0; i <= old_mask; ++i)
+        {
+            const uint32_t key = old_base + uint32_t(i);
+            Bucket& bucket = old[key & old_mask];
+            if (!bucket.empty()) { buckets_[key & mask_] = std::move(bucket); }
+        }
+        cursor_ = new_base;
+    }
+
+    bool UsingStackBuffer() const noexcept
+    {
+        if (!buckets_.using_stack_buffer()) { return false; }
+        for (const Bucket& bucket : buckets_) { if (!bucket.using_stack_buffer()) { return false; } }
+        return true;
+    }
+};
+
+//=====================================================================================================================
+// Open List Policies
+//=====================================================================================================================
+
+// SboAStar takes its open list as a template, both expose push(key, value) / pop_min() / empty() / clear()
+//     the key is the f cost, the value carries it too so the heap can order by it
+
+template <typename T, size_t size_threshold>
+class SboHeapOpenList
+{
+public:
+    void push(uint32_t, const T& value)                 { heap_.push(value); }
+    T pop_min() noexcept                                { return heap_.pop_min(); }
+    void clear() noexcept                               { heap_.clear(); }
+    bool empty() const noexcept                         { return heap_.empty(); }
+    bool using_stack_buffer() const noexcept            { return heap_.using_stack_buffer(); }
+
+private:
+    SboPriorityQueue<T, size_threshold> heap_;
+};
+
+// integer edge costs only, f must be monotone (consistent heuristic), the size threshold is per bucket here
+template <typename T, size_t>
+using SboBucketOpenList = SboBucketQueue<T, 8>;
+
+//=====================================================================================================================
+// Grid Map
+//=====================================================================================================================
+
+// costs are integers so the search never accumulates float error, straight steps cost 10 * cell cost and
+// diagonal steps cost 14 * cell cost (octile distance scaled by 10)
+class SboGridMap
+{
+public:
+    static constexpr uint32_t straight_step = 10;
+    static constexpr uint32_t diagonal_step = 14;
+
+    SboGridMap(uint32_t width, uint32_t height, bool diagonal = false)
+        : width_(width), height_(height), diagonal_(diagonal), costs_(size_t(width) * height, uint8_t(1)) {}
+
+    uint32_t width() const noexcept                     { return width_; }
+    uint32_t height() const noexcept                    { return height_; }
+    uint32_t node_count() const noexcept                { return width_ * height_; }
+    uint32_t node(uint32_t x, uint32_t y) const noexcept{ assert(x < width_ && y < height_); return y * width_ + x; }
+    uint32_t x_of(uint32_t node) const noexcept         { return node % width_; }
+    uint32_t y_of(uint32_t node) const noexcept         { return node / width_; }
+
+    // 0 == blocked, otherwise the cost of stepping into the cell
+    uint8_t cost(uint32_t x, uint32_t y) const noexcept { return costs_[node(x, y)]; }
+    void set_cost(uint32_t x, uint32_t y, uint8_t c)    { costs_[node(x, y)] = c; }
+    bool passable(uint32_t node) const noexcept         { return costs_[node] != 0; }
+
+    uint32_t heuristic(uint32_t from, uint32_t to) const noexcept { return Heuristic(from, to); }
+
+    template <typename F>
+    void for_each_neighbor(uint32_t node, F&& fn) const { ForEachNeighbor(node, fn); }
+
+private:
+    inline uint32_t Heuristic(uint32_t from, uint32_t to) const noexcept
+    {
+        uint32_t dx = (x_of(from) > x_of(to)) ? x_of(from) - x_of(to) : x_of(to) - x_of(from);
+        uint32_t dy = (y_of(from) > y_of(to)) ? y_of(from) - y_of(to) : y_of(to) - y_of(from);
+        if (!diagonal_) { return straight_step * (dx + dy); }
+
+        uint32_t lo = std::min(dx, dy);
+        uint32_t hi = std::max(dx, dy);
+        return diagonal_step * lo + straight_step * (hi - lo);
+    }
+
+    template <typename F>
+    inline void ForEachNeighbor(uint32_t node, F& fn) const
+    {
+        const int32_t x = int32_t(x_of(node));
+        const int32_t y = int32_t(y_of(node));
+
+        static constexpr int32_t offsets[8][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, 1}, {1, -1}, {-1, -1} };
+        const int directions = diagonal_ ? 8 : 4;
+        for (int i = 0; i < directions; ++i)
+        {
+            const int32_t nx = x + offsets[i][0];
+            const int32_t ny = y + offsets[i][1];
+            if (nx < 0 || ny < 0 || nx >= int32_t(width_) || ny >= int32_t(height_)) { continue; }
+
+            const uint32_t neighbor = uint32_t(ny) * width_ + uint32_t(nx);
+            const uint8_t c = costs_[neighbor];
+            if (c == 0) { continue; }
+
+            // no corner cutting, both orthogonal cells must be open for a diagonal step
+            if (i >= 4 && (costs_[uint32_t(y) * width_ + uint32_t(nx)] == 0 || costs_[uint32_t(ny) * width_ + uint32_t(x)] == 0)) { continue; }
+
+            fn(neighbor, uint32_t(c) * ((i < 4) ? straight_step : diagonal_step));
+        }
+    }
+
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    bool diagonal_ = false;
+    SboArray<uint8_t, 64> costs_;
+};
+
+//=====================================================================================================================
+// A*
+//=====================================================================================================================
+
+template <typename Graph, size_t size_threshold = 64, template <typename, size_t> class OpenList = SboHeapOpenList>
+class SboAStar
+{
+public:
+    static constexpr uint32_t invalid_node = ~uint32_t(0);
+
+    // fills path with start..goal inclusive, returns false (and leaves path empty) if goal is unreachable
+    template <size_t path_threshold>
+    bool find_path(const Graph& graph, uint32_t start, uint32_t goal, SboArray<uint32_t, path_threshold>& path)
+    { return FindPath(graph, start, goal, path); }
+
+    // stats for the last search
+    size_t nodes_expanded() const noexcept              { return nodes_expanded_; }
+    size_t nodes_visited() const noexcept               { return records_.size(); }
+    uint32_t path_cost() const noexcept                 { return path_cost_; }
+    bool used_stack_only() const noexcept               { return open_.using_stack_buffer() && records_.using_stack_buffer() && lookup_.using_stack_buffer() && lookup_used_.using_stack_buffer(); }
+
+//=====================================================================================================================
+// Underlying Data
+//=====================================================================================================================
+
+private:
+    struct Record
+    {
+        uint32_t node;
+        uint32_t parent;    // index into records_, invalid_node for the start
+        uint32_t g;
+        bool closed;
+    };
+
+    struct OpenEntry
+    {
+        uint32_t f;
+        uint32_t g;
+        uint32_t record;
+
+        // prefer the deeper node on ties, it tends to reach the goal with fewer expansions
+        bool operator<(const OpenEntry& rhs) const noexcept { return (f != rhs.f) ? f < rhs.f : g > rhs.g; }
+    };
+
+    OpenList<OpenEntry, size_threshold> open_;
+    SboArray<Record, size_threshold> records_;
+
+    // closed set lookup, open addressing with linear probing, node id -> record index
+    //     capacity is always a power of two and kept under half full
+    //     a slot is occupied iff it is marked in lookup_used_, so starting a new search is O(1) even after a
+    //     big search left the table large
+    static constexpr size_t NextPowerOfTwo(size_t n) { size_t p = 1; while (p < n) { p <<= 1; } return p; }
+    static constexpr size_t lookup_threshold = NextPowerOfTwo(size_threshold * 2);
+    SboArray<uint32_t, lookup_threshold> lookup_;
+    SboMarkerArray<lookup_threshold> lookup_used_;
+
+    size_t nodes_expanded_ = 0;
+    uint32_t path_cost_ = 0;
+
+//=====================================================================================================================
+// Implementation
+//=====================================================================================================================
+
+    template <size_t path_threshold>
+    bool FindPath(const Graph& graph, uint32_t start, uint32_t goal, SboArray<uint32_t, path_threshold>& path)
+    {
+        path.clear();
+        Reset();
+        if (start >= graph.node_count() || goal >= graph.node_count()) { return false; }
+
+        uint32_t start_record = FindOrAddRecord(start);
+        records_[start_record].g = 0;
+        const uint32_t start_f = graph.heuristic(start, goal);
+        open_.push(start_f, { start_f, 0, start_record });
+
+        while (!open_.empty())
+        {
+            const OpenEntry current = open_.pop_min();
+
+            // lazy deletion, a cheaper path to this node was pushed after this entry
+            Record& record = records_[current.record];
+            if (record.closed || current.g != record.g) { continue; }
+            record.closed = true;
+            ++nodes_expanded_;
+
+            if (record.node == goal)
+            {
+                path_cost_ = record.g;
+                BuildPath(current.record, path);
+                return true;
+            }
+
+            const uint32_t current_node = record.node;
+            const uint32_t current_g = current.g;
+            graph.for_each_neighbor(current_node, [&](uint32_t neighbor, uint32_t cost)
+            {
+                const uint32_t g = current_g + cost;
+                const uint32_t index = FindOrAddRecord(neighbor);
+                Record& next = records_[index]; // FindOrAddRecord may have grown records_
+                if (next.closed || g >= next.g) { return; }
+
+                next.g = g;
+                next.parent = current.record;
+                const uint32_t f = g + graph.heuristic(neighbor, goal);
+                open_.push(f, { f, g, index });
+            });
+        }
+        return false;
+    }
+
+    inline void Reset()
+    {
+        open_.clear();
+        records_.clear();
+        nodes_expanded_ = 0;
+        path_cost_ = 0;
+
+        if (lookup_.empty()) { ResizeLookup(lookup_threshold); }
+        else { lookup_used_.clear(); }
+    }
+
+    static inline uint32_t Hash(uint32_t node) noexcept { return node * 0x9E3779B1u; }
+
+    inline uint32_t FindOrAddRecord(uint32_t node)
+    {
+        const size_t mask = lookup_.size() - 1;
+        size_t slot = Hash(node) & mask;
+        while (lookup_used_.test(slot))
+        {
+            const uint32_t index = lookup_[slot];
+            if (records_[index].node == node) { return index; }
+            slot = (slot + 1) & mask;
+        }
+
+        const uint32_t index = uint32_t(records_.size());
+        records_.push_back({ node, invalid_node, ~uint32_t(0), false });
+        lookup_[slot] = index;
+        lookup_used_.set(slot);
+
+        if (records_.size() * 2 > lookup_.size()) { GrowLookup(); }
+        return index;
+    }
+
+    void ResizeLookup(size_t size)
+    {
+        lookup_ = SboArray<uint32_t, lookup_threshold>(size);
+        lookup_used_.resize(size);
+    }
+
+    void GrowLookup()
+    {
+        ResizeLookup(lookup_.size() * 2);
+        const size_t mask = lookup_.size() - 1;
+        for (uint32_t index = 0; index < records_.size(); ++index)
+        {
+            size_t slot = Hash(records_[index].node) & mask;
+            while (lookup_used_.test_and_set(slot)) { slot = (slot + 1) & mask; }
+            lookup_[slot] = index;
+        }
+    }
+
+    template <size_t path_threshold>
+    void BuildPath(uint32_t record, SboArray<uint32_t, path_threshold>& path)
+    {
+        for (uint32_t r = record; r != invalid_node; r = records_[r].parent) { path.push_back(records_[r].node); }
+        std::reverse(path.begin(), path.end());
+    }
+};
+
+#endif // SBOPATHFINDING_H
@@ -0,0 +1,199 @@
+//=====================================================================================================================
+// MIT License
+//
+// Copyright (c) 2025 Cory Simonich
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//=====================================================================================================================
+
+//=====================================================================================================================
+//
+// Pathfinding Benchmark
+//
+//
+// regression gauge for container changes that affect pathfinding
+//     random grid maps, searches bucketed by manhattan distance between start and goal
+//     reports allocations per search, heap spills per search and expanded nodes per second for each bucket
+//     the _heap / _bucket suites compare the binary heap and Dial bucket open lists on a reused searcher
+//
+// build:
+//      g++ -O2 -std=c++20 -DSBOARRAY_TRACK_ALLOCATIONS sbo_pathfinding_bench.cpp -o sbo_pathfinding_bench
+//
+// results go to stdout and to bench_output.txt as csv so they can be graphed
+//
+//=====================================================================================================================
+
+#ifndef SBOARRAY_TRACK_ALLOCATIONS
+    #define SBOARRAY_TRACK_ALLOCATIONS
+#endif
+
+#include "sbo_pathfinding.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace
+{
+    constexpr uint32_t map_size = 256;
+    constexpr float obstacle_ratio = 0.2f;
+    constexpr int searches_per_bucket = 500;
+    constexpr uint32_t buckets[] = { 4, 8, 16, 32, 64, 128, 256 };
+
+    struct BucketResult
+    {
+        uint32_t distance = 0;
+        int searches = 0;
+        int found = 0;
+        size_t allocations = 0;
+        size_t spills = 0;
+        size_t stack_only = 0;
+        size_t nodes_expanded = 0;
+        size_t path_nodes = 0;
+        double seconds = 0.0;
+    };
+
+    SboGridMap MakeRandomMap(std::mt19937& rng, bool diagonal)
+    {
+        SboGridMap map(map_size, map_size, diagonal);
+        std::uniform_real_distribution<float> roll(0.0f, 1.0f);
+        std::uniform_int_distribution<int> terrain(1, 4);
+        for (uint32_t y = 0; y < map_size; ++y)
+        {
+            for (uint32_t x = 0; x < map_size; ++x)
+            {
+                map.set_cost(x, y, (roll(rng) < obstacle_ratio) ? 0 : uint8_t(terrain(rng)));
+            }
+        }
+        return map;
+    }
+
+    // random open start cell, goal is an open cell at exactly `distance` manhattan steps when one can be found
+    bool PickEndpoints(std::mt19937& rng, const SboGridMap& map, uint32_t distance, uint32_t& start, uint32_t& goal)
+    {
+        std::uniform_int_distribution<uint32_t> coord(0, map_size - 1);
+        for (int attempt = 0; attempt < 64; ++attempt)
+        {
+            const uint32_t sx = coord(rng);
+            const uint32_t sy = coord(rng);
+            std::uniform_int_distribution<uint32_t> split(0, distance);
+            const uint32_t dx = split(rng);
+            const uint32_t dy = distance - dx;
+            const int64_t gx = int64_t(sx) + ((rng() & 1) ? int64_t(dx) : -int64_t(dx));
+            const int64_t gy = int64_t(sy) + ((rng() & 1) ? int64_t(dy) : -int64_t(dy));
+            if (gx < 0 || gy < 0 || gx >= int64_t(map_size) || gy >= int64_t(map_size)) { continue; }
+
+            start = map.node(sx, sy);
+            goal = map.node(uint32_t(gx), uint32_t(gy));
+            if (map.passable(start) && map.passable(goal)) { return true; }
+        }
+        return false;
+    }
+
+    template <size_t threshold, template <typename, size_t> class OpenList>
+    BucketResult RunBucket(std::mt19937& rng, const SboGridMap& map, uint32_t distance, bool reuse)
+    {
+        BucketResult result;
+        result.distance = distance;
+
+        // reuse == one long lived searcher, the open list and closed set keep their capacity between searches
+        SboAStar<SboGridMap, threshold, OpenList> shared;
+
+        for (int i = 0; i < searches_per_bucket; ++i)
+        {
+            uint32_t start = 0;
+            uint32_t goal = 0;
+            if (!PickEndpoints(rng, map, distance, start, goal)) { continue; }
+
+            // otherwise a fresh searcher and path each time, this is the "short path stays on the stack" case
+            SboArrayStats::Reset();
+            const auto t0 = std::chrono::steady_clock::now();
+
+            SboAStar<SboGridMap, threshold, OpenList> local;
+            SboAStar<SboGridMap, threshold, OpenList>& astar = reuse ? shared : local;
+            SboArray<uint32_t, threshold> path;
+            const bool found = astar.find_path(map, start, goal, path);
+
+            const auto t1 = std::chrono::steady_clock::now();
+
+            ++result.searches;
+            result.found += found ? 1 : 0;
+            result.allocations += SboArrayStats::allocations;
+            result.spills += SboArrayStats::spills;
+            result.stack_only += astar.used_stack_only() && path.using_stack_buffer();
+            result.nodes_expanded += astar.nodes_expanded();
+            result.path_nodes += path.size();
+            result.seconds += std::chrono::duration<double>(t1 - t0).count();
+        }
+        return result;
+    }
+
+    template <size_t threshold, template <typename, size_t> class OpenList = SboHeapOpenList>
+    void RunSuite(FILE* csv, const char* label, const SboGridMap& map, uint32_t seed, bool reuse = false)
+    {
+        std::mt19937 rng(seed);
+        std::printf("\n%s (size_threshold = %zu%s)\n", label, threshold, reuse ? ", reused searcher" : "");
+        std::printf("%8s %8s %8s %10s %10s %10s %10s %14s\n", "dist", "found", "path", "allocs/q", "spills/q", "stack %", "expand/q", "nodes/s");
+
+        for (uint32_t distance : buckets)
+        {
+            const BucketResult r = RunBucket<threshold, OpenList>(rng, map, distance, reuse);
+            if (r.searches == 0) { continue; }
+
+            const double q = double(r.searches);
+            const double nodes_per_second = (r.seconds > 0.0) ? double(r.nodes_expanded) / r.seconds : 0.0;
+            std::printf("%8u %8d %8.1f %10.2f %10.2f %10.1f %10.1f %14.0f\n",
+                r.distance, r.found, double(r.path_nodes) / q, double(r.allocations) / q, double(r.spills) / q,
+                100.0 * double(r.stack_only) / q, double(r.nodes_expanded) / q, nodes_per_second);
+
+            if (csv)
+            {
+                std::fprintf(csv, "%s%s,%zu,%u,%d,%d,%.2f,%.4f,%.4f,%.4f,%.2f,%.0f\n",
+                    label, reuse ? "_reused" : "", threshold, r.distance, r.searches, r.found, double(r.path_nodes) / q,
+                    double(r.allocations) / q, double(r.spills) / q, double(r.stack_only) / q, double(r.nodes_expanded) / q,
+                    nodes_per_second);
+            }
+        }
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(1234);
+    const SboGridMap grid4 = MakeRandomMap(rng, false);
+    const SboGridMap grid8 = MakeRandomMap(rng, true);
+
+    FILE* csv = std::fopen("bench_output.txt", "w");
+    if (csv) { std::fprintf(csv, "suite,threshold,distance,searches,found,path_nodes,allocs_per_search,spills_per_search,stack_only_ratio,expanded_per_search,nodes_per_second\n"); }
+
+    RunSuite<64>(csv, "grid4", grid4, 42);
+    RunSuite<256>(csv, "grid4", grid4, 42);
+    RunSuite<64>(csv, "grid8", grid8, 42);
+    RunSuite<256>(csv, "grid8", grid8, 42);
+
+    // integer costs, heap vs Dial buckets on the same searches
+    RunSuite<64, SboHeapOpenList>(csv, "grid8_heap", grid8, 42, true);
+    RunSuite<64, SboBucketOpenList>(csv, "grid8_bucket", grid8, 42, true);
+    RunSuite<64, SboHeapOpenList>(csv, "grid4_heap", grid4, 42, true);
+    RunSuite<64, SboBucketOpenList>(csv, "grid4_bucket", grid4, 42, true);
+
+    if (csv) { std::fclose(csv); }
+    return 0;
+}
@@ -0,0 +1,228 @@
+//=====================================================================================================================
+// MIT License
+//
+// Copyright (c) 2025 Cory Simonich
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//=====================================================================================================================
+
+//=====================================================================================================================
+//
+// Pipeline
+//
+//
+// lazy filter/transform/take over an SboArray (or anything with data() and size()), nothing runs until the
+//     pipeline is collected or walked, and no stage builds an intermediate array
+//
+//     every stage knows an upper bound on how many values can come out of it (the source size, filter keeps it,
+//     take clamps it), collect() reserves that once, writes without any capacity checks and then gives the
+//     memory back (back to the inline buffer when the result fits in it), collect_into() leaves the caller's
+//     capacity alone so a buffer reused every frame stops reallocating
+//
+//     push based, the source loop calls down through the stages, all of it inlines into one loop
+//     take stops the source loop as soon as it has enough
+//
+// the pipeline holds a pointer to the source and copies of the lambdas, the source has to outlive it
+//
+// Example:
+//
+//      auto nearby = SboPipeline(entities)
+//          .filter([&](const Entity& e) { return DistanceSq(e.pos, player) < radius_sq; })
+//          .transform([](const Entity& e) { return e.id; })
+//          .take(16)
+//          .collect<SboArray<u32, 16>>();
+//
+//=====================================================================================================================
+
+
+#ifndef SBOPIPELINE_H
+#define SBOPIPELINE_H
+
+#include "sbo_array.h"
+
+#include <algorithm>    // min
+#include <type_traits>  // is_trivially_copyable_v, remove_pointer_t
+#include <utility>      // move, in_place_t
+
+//=====================================================================================================================
+// Stages
+//=====================================================================================================================
+
+// every stage has size_bound() and run(sink), sink(value) returns false to stop, run returns false if stopped
+
+template <typename T>
+struct SboSourceStage
+{
+    T* first;
+    size_t count;
+
+    size_t size_bound() const noexcept                  { return count; }
+
+    template <typename Sink>
+    bool run(Sink& sink) const
+    {
+        for (T* it = first, *last = first + count; it != last; ++it) { if (!sink(*it)) { return false; } }
+        return true;
+    }
+};
+
+template <typename Prev, typename Pred>
+struct SboFilterStage
+{
+    Prev prev;
+    Pred pred;
+
+    size_t size_bound() const noexcept                  { return prev.size_bound(); }
+
+    template <typename Sink>
+    bool run(Sink& sink) const
+    {
+        auto pass = [&](auto&& value) { return !pred(value) || sink(std::forward<decltype(value)>(value)); };
+        return prev.run(pass);
+    }
+};
+
+template <typename Prev, typename Fn>
+struct SboTransformStage
+{
+    Prev prev;
+    Fn fn;
+
+    size_t size_bound() const noexcept                  { return prev.size_bound(); }
+
+    template <typename Sink>
+    bool run(Sink& sink) const
+    {
+        auto map = [&](auto&& value) { return sink(fn(std::forward<decltype(value)>(value))); };
+        return prev.run(map);
+    }
+};
+
+template <typename Prev>
+struct SboTakeStage
+{
+    Prev prev;
+    size_t limit;
+
+    size_t size_bound() const noexcept                  { return std::min(prev.size_bound(), limit); }
+
+    template <typename Sink>
+    bool run(Sink& sink) const
+    {
+        if (limit == 0) { return true; }
+        size_t left = limit;
+        auto count = [&](auto&& value) { return sink(std::forward<decltype(value)>(value)) && --left != 0; };
+        return prev.run(count) || left == 0;
+    }
+};
+
+//=====================================================================================================================
+// SboPipeline
+//=====================================================================================================================
+
+template <typename Stage>
+class SboPipeline
+{
+
+//=====================================================================================================================
+// Public Api
+//=====================================================================================================================
+public:
+    // the source, anything contiguous with data() and size()
+    template <typename Container>
+    explicit SboPipeline(Container& source)             : stage_{ source.data(), source.size() } {}
+    SboPipeline(std::in_place_t, Stage stage)           : stage_(std::move(stage)) {}
+
+    // adaptors, each returns a new pipeline, the one it was called on is left untouched
+    template <typename Pred>
+    auto filter(Pred pred) const                        { return Then(SboFilterStage<Stage, Pred>{ stage_, std::move(pred) }); }
+    template <typename Fn>
+    auto transform(Fn fn) const                         { return Then(SboTransformStage<Stage, Fn>{ stage_, std::move(fn) }); }
+    auto take(size_t n) const                           { return Then(SboTakeStage<Stage>{ stage_, n }); }
+
+    // terminals
+    template <typename Out>
+    Out collect() const                                 { Out out; Collect(out); Trim(out); return out; }
+    template <typename Out>
+    void collect_into(Out& out) const                   { Collect(out); }   // appends, keeps whatever capacity out grew to
+    template <typename Fn>
+    void for_each(Fn fn) const                          { auto sink = [&](auto&& value) { fn(std::forward<decltype(value)>(value)); return true; }; stage_.run(sink); }
+    size_t count() const                                { size_t n = 0; auto sink = [&](auto&&) { ++n; return true; }; stage_.run(sink); return n; }
+
+    // the most values that can come out, exact when there is no filter
+    size_t size_bound() const noexcept                  { return stage_.size_bound(); }
+
+//=====================================================================================================================
+// Underlying Data
+//=====================================================================================================================
+
+private:
+    Stage stage_;
+
+//=====================================================================================================================
+// Implementation
+//=====================================================================================================================
+
+    template <typename Next>
+    static SboPipeline<Next> Then(Next next)            { return SboPipeline<Next>(std::in_place, std::move(next)); }
+
+    template <typename Out>
+    void Collect(Out& out) const
+    {
+        using U = typename Out::value_type;
+        constexpr bool pod = std::is_trivially_copyable_v<U> && std::is_trivially_default_constructible_v<U> &&
+                             std::is_trivially_destructible_v<U>;
+
+        const size_t old_size = out.size();
+        const size_t bound = old_size + stage_.size_bound();
+
+        // one reservation for the worst case, then no capacity checks per value
+        if_constexpr (pod)
+        {
+            out.resize_and_overwrite(bound, [&](U* data, size_t)
+            {
+                U* write = data + old_size;
+                auto sink = [&](auto&& value) { *write++ = U(std::forward<decltype(value)>(value)); return true; };
+                stage_.run(sink);
+                return size_t(write - data);
+            });
+        }
+        else
+        {
+            out.reserve(bound);
+            auto sink = [&](auto&& value) { out.emplace_back(std::forward<decltype(value)>(value)); return true; };
+            stage_.run(sink);
+        }
+    }
+
+    // only for collect(), where out is ours, a buffer reused through collect_into keeps its capacity
+    //     a filter usually leaves most of the bound unused, hand it back when that is at least half the capacity
+    //     or when the result fits the inline buffer again
+    template <typename Out>
+    static void Trim(Out& out)
+    {
+        if (!out.using_stack_buffer() && (out.size() * 2 <= out.capacity() || out.size() <= Out::inline_capacity)) { out.shrink_to_fit(); }
+    }
+};
+
+template <typename Container>
+SboPipeline(Container&) -> SboPipeline<SboSourceStage<std::remove_pointer_t<decltype(std::declval<Container&>().data())>>>;
+
+#endif // SBOPIPELINE_H
@@ -0,0 +1,253 @@
+//=====================================================================================================================
+// MIT License
+//
+// Copyright (c) 2025 Cory Simonich
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//=====================================================================================================================
+
+//=====================================================================================================================
+//
+// Polymorphic Array
+//
+//
+// replacement for SboArray<std::unique_ptr<Base>> when the set of derived types is known up front
+//     every element lives in a fixed size slot (the biggest of Types), back to back in one SboArray, no
+//     allocation and no pointer chase per element
+//     every slot carries a one byte type tag, per type operations (move, destroy, cast to Base) live in a
+//     static table indexed by the tag
+//
+// two ways to walk it
+//     for (Base& b : array)        Base& through the tag table, then whatever virtual calls Base has
+//     array.visit(fn)              fn(Derived&) with the concrete type, one indirect call per element into
+//                                  code where every call on the element is static, Base needs no virtuals at all
+//
+// elements are moved with their own move constructor when the array grows or erases, so any nothrow movable
+//     type works, if every type is trivially copyable the slots are too and growth is a memcpy
+//
+// Example:
+//
+//      SboPolyArray<Behavior, 32, Wander, Chase, Flee> behaviors;
+//      behaviors.emplace_back<Chase>(target, 4.0f);
+//      behaviors.emplace_back<Wander>(radius);
+//
+//      for (Behavior& b : behaviors) { b.Update(dt); }             // virtual
+//      behaviors.visit([&](auto& b) { b.Update(dt); });            // static
+//
+//=====================================================================================================================
+
+
+#ifndef SBOPOLYARRAY_H
+#define SBOPOLYARRAY_H
+
+#include "sbo_array.h"
+
+#include <algorithm>    // max
+#include <cstddef>      // max_align_t
+#include <cstdint>      // uint8_t
+#include <type_traits>  // is_base_of_v
+#include <utility>      // forward, move
+
+template <typename Base, size_t size_threshold, typename... Types>
+class SboPolyArray
+{
+    static_assert(sizeof...(Types) > 0 && sizeof...(Types) < 255, "SboPolyArray needs between 1 and 254 types");
+    static_assert((std::is_base_of_v<Base, Types> && ...), "SboPolyArray types must all derive from Base");
+    static_assert((std::is_nothrow_move_constructible_v<Types> && ...), "SboPolyArray types must be nothrow move constructible");
+
+//=====================================================================================================================
+// Public Api
+//=====================================================================================================================
+public:
+    static constexpr size_t slot_size = std::max({ sizeof(Types)... });
+    static constexpr size_t slot_align = std::max({ alignof(Types)... });
+    // the stack buffer is aligned for the slot, but a spilled block only comes from malloc/operator new
+    static_assert(slot_align <= alignof(std::max_align_t), "SboPolyArray types can not be aligned past max_align_t");
+
+    // tag of a type, usable in a switch
+    template <typename D>
+    static constexpr uint8_t tag_of()                   { return TagOf<D>(); }
+
+    // push/pop
+    template <typename D, typename... Args>
+    D& emplace_back(Args&&... args)                     { return EmplaceBack<D>(std::forward<Args>(args)...); }
+    template <typename D>
+    void push_back(D&& value)                           { EmplaceBack<std::decay_t<D>>(std::forward<D>(value)); }
+    void pop_back() noexcept                            { slots_.pop_back(); }
+    void erase(size_t i)                                { slots_.erase(slots_.begin() + i); }
+    void clear() noexcept                               { slots_.clear(); }
+    void reserve(size_t new_cap)                        { slots_.reserve(new_cap); }
+
+    // query
+    bool empty() const noexcept                         { return slots_.empty(); }
+    size_t size() const noexcept                        { return slots_.size(); }
+    size_t capacity() const noexcept                    { return slots_.capacity(); }
+    inline bool using_stack_buffer() const noexcept     { return slots_.using_stack_buffer(); }
+    uint8_t tag(size_t i) const noexcept                { return slots_[i].tag; }
+    template <typename D>
+    bool holds(size_t i) const noexcept                 { return slots_[i].tag == TagOf<D>(); }
+
+    // accessors
+    Base& operator[](size_t i) noexcept                 { return *ToBase(slots_[i]); }
+    const Base& operator[](size_t i) const noexcept     { return *ToBase(const_cast<Slot&>(slots_[i])); }
+    template <typename D>
+    D& get(size_t i) noexcept                           { assert(holds<D>(i)); return *Object<D>(slots_[i]); }
+    template <typename D>
+    const D& get(size_t i) const noexcept               { assert(holds<D>(i)); return *Object<D>(const_cast<Slot&>(slots_[i])); }
+
+    // fn(Derived&) for every element in order, fn is usually a generic lambda
+    template <typename F>
+    void visit(F&& fn)                                  { Visit<Types...>(fn); }
+    template <typename F>
+    void visit(F&& fn) const                            { const_cast<SboPolyArray*>(this)->template Visit<const Types...>(fn); }
+
+    // iterators, yield Base&
+    template <typename Owner, typename Ref>
+    class Iterator
+    {
+    public:
+        Iterator(Owner* owner, size_t index) : owner_(owner), index_(index) {}
+        Ref operator*() const noexcept                  { return (*owner_)[index_]; }
+        auto operator->() const noexcept                { return &(*owner_)[index_]; }
+        Iterator& operator++() noexcept                 { ++index_; return *this; }
+        bool operator==(const Iterator& rhs) const noexcept { return index_ == rhs.index_; }
+        bool operator!=(const Iterator& rhs) const noexcept { return index_ != rhs.index_; }
+
+    private:
+        Owner* owner_;
+        size_t index_;
+    };
+    using iterator = Iterator<SboPolyArray, Base&>;
+    using const_iterator = Iterator<const SboPolyArray, const Base&>;
+
+    iterator begin() noexcept                           { return iterator(this, 0); }
+    iterator end() noexcept                             { return iterator(this, size()); }
+    const_iterator begin() const noexcept               { return const_iterator(this, 0); }
+    const_iterator end() const noexcept                 { return const_iterator(this, size()); }
+
+//=====================================================================================================================
+// Underlying Data
+//=====================================================================================================================
+
+private:
+    static constexpr uint8_t empty_tag_ = 0xFF;
+    static constexpr bool plain_old_data_ = ((std::is_trivially_copyable_v<Types> && std::is_trivially_destructible_v<Types>) && ...);
+
+    struct Ops
+    {
+        void (*move)(void* dest, void* src);    // move constructs dest from src, then destroys src
+        void (*destroy)(void* object);
+        Base* (*to_base)(void* object);
+    };
+
+    template <typename D>
+    static constexpr Ops OpsFor()
+    {
+        return
+        {
+            [](void* dest, void* src) { D* from = static_cast<D*>(src); new (dest) D(std::move(*from)); from->~D(); },
+            [](void* object) { static_cast<D*>(object)->~D(); },
+            [](void* object) -> Base* { return static_cast<D*>(object); },
+        };
+    }
+    static constexpr Ops ops_[sizeof...(Types)] = { OpsFor<Types>()... };
+
+    // trivial so SboArray moves it with memcpy, the tag is always written right after the object is constructed
+    struct PodSlot
+    {
+        alignas(slot_align) unsigned char bytes[slot_size];
+        uint8_t tag;
+    };
+
+    struct ObjectSlot
+    {
+        alignas(slot_align) unsigned char bytes[slot_size];
+        uint8_t tag = empty_tag_;
+
+        ObjectSlot() noexcept {}
+        ObjectSlot(ObjectSlot&& rhs) noexcept           { Take(rhs); }
+        ObjectSlot& operator=(ObjectSlot&& rhs) noexcept { if (this != &rhs) { Reset(); Take(rhs); } return *this; }
+        ~ObjectSlot()                                   { Reset(); }
+
+        void Take(ObjectSlot& rhs) noexcept
+        {
+            tag = rhs.tag;
+            if (tag != empty_tag_) { ops_[tag].move(bytes, rhs.bytes); rhs.tag = empty_tag_; }
+        }
+        void Reset() noexcept
+        {
+            if (tag != empty_tag_) { ops_[tag].destroy(bytes); tag = empty_tag_; }
+        }
+    };
+
+    using Slot = std::conditional_t<plain_old_data_, PodSlot, ObjectSlot>;
+
+    SboArray<Slot, size_threshold> slots_;
+
+//=====================================================================================================================
+// Implementation
+//=====================================================================================================================
+
+    template <typename D>
+    static constexpr uint8_t TagOf()
+    {
+        constexpr bool matches[] = { std::is_same_v<D, Types>... };
+        for (uint8_t i = 0; i < sizeof...(Types); ++i) { if (matches[i]) { return i; } }
+        return empty_tag_;
+    }
+
+    template <typename D>
+    static inline D* Object(Slot& slot) noexcept        { return std::launder(reinterpret_cast<D*>(slot.bytes)); }
+    static inline Base* ToBase(Slot& slot) noexcept     { assert(slot.tag != empty_tag_); return ops_[slot.tag].to_base(slot.bytes); }
+
+    template <typename D, typename... Args>
+    D& EmplaceBack(Args&&... args)
+    {
+        static_assert(TagOf<D>() != empty_tag_, "SboPolyArray::emplace_back type is not in Types");
+        // the slot is only kept once D is built, if D's constructor throws the empty slot comes back off
+        struct Rollback
+        {
+            SboArray<Slot, size_threshold>& slots;
+            bool committed = false;
+            ~Rollback()                                 { if (!committed) { slots.pop_back(); } }
+        };
+
+        Slot& slot = slots_.emplace_back();
+        Rollback rollback{ slots_ };
+        D* object = new (slot.bytes) D(std::forward<Args>(args)...);
+        slot.tag = TagOf<D>();
+        rollback.committed = true;
+        return *object;
+    }
+
+    // one thunk per type, built once per visitor type, the loop is one indirect call per element
+    template <typename... Qualified, typename F>
+    void Visit(F& fn)
+    {
+        using Thunk = void (*)(void*, F&);
+        static constexpr Thunk thunks[] = { [](void* object, F& f) { f(*static_cast<Qualified*>(object)); }... };
+
+        Slot* slot = slots_.data();
+        Slot* const end = slot + slots_.size();
+        for (; slot != end; ++slot) { thunks[slot->tag](slot->bytes, fn); }
+    }
+};
+
+#endif // SBOPOLYARRAY_H
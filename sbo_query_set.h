@@ -0,0 +1,179 @@
+//=====================================================================================================================
+// MIT License
+//
+// Copyright (c) 2025 Cory Simonich
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//=====================================================================================================================
+
+//=====================================================================================================================
+//
+// Query Set
+//
+//
+// the entities_to_process list from the SboArray example, kept up to date instead of rebuilt every frame
+//     the set is told when an entity's flags change (on_flags_changed, or subscribe() it to an SboCallbackList),
+//     an entity that starts or stops matching queues an insert or a remove, everything else is ignored
+//     flush() applies the queue, per frame cost is the number of changes, not the number of entities
+//
+// members are a dense SboArray of ids plus a sparse id -> slot index, remove is swap and pop, so the order is
+//     not stable across flushes
+//
+// nothing touches the members between flushes, iterating them is frame stable even while the loop body
+//     changes flags (those changes just queue up), call flush() once per frame outside of any iteration
+//
+// Example:
+//
+//      SboQuerySet<u64> to_process(SOME_ENTITY_FLAG | SOME_OTHER_ENTITY_FLAG);
+//      auto handle = to_process.subscribe(EntitySystem::on_flags_changed);   // SboCallbackList<void(u32, u64, u64)>
+//
+//      to_process.flush();
+//      for (u32 e : to_process)
+//      {
+//          EntitySystem::DoTheThing(e);    // may change flags, to_process sees it next flush
+//      }
+//
+//=====================================================================================================================
+
+
+#ifndef SBOQUERYSET_H
+#define SBOQUERYSET_H
+
+#include "sbo_array.h"
+
+#include <algorithm>    // max
+#include <cstdint>      // uint32_t
+
+template <typename Flags = uint64_t, size_t size_threshold = 64>
+class SboQuerySet
+{
+
+//=====================================================================================================================
+// Public Api
+//=====================================================================================================================
+public:
+    // an entity matches when it has every required flag and none of the excluded ones
+    explicit SboQuerySet(Flags required, Flags excluded = Flags(0)) : required_(required), excluded_(excluded) {}
+
+    // change notifications, queued until flush()
+    void on_flags_changed(uint32_t entity, Flags old_flags, Flags new_flags) { OnFlagsChanged(entity, old_flags, new_flags); }
+    void on_destroyed(uint32_t entity)                  { Queue(entity, false); }
+    void insert(uint32_t entity)                        { Queue(entity, true); }
+    void erase(uint32_t entity)                         { Queue(entity, false); }
+
+    // list is an SboCallbackList<void(uint32_t, Flags, Flags)> (or anything with add(fn)), returns its handle,
+    //     remove it from the list before the set goes away
+    template <typename List>
+    auto subscribe(List& list)                          { return list.add([this](uint32_t e, Flags o, Flags n) { OnFlagsChanged(e, o, n); }); }
+
+    // applies the queued changes in the order they came in, O(changes)
+    void flush()                                        { Flush(); }
+    void clear() noexcept                               { Clear(); }
+
+    // query, members as of the last flush
+    bool matches(Flags flags) const noexcept            { return (flags & required_) == required_ && (flags & excluded_) == Flags(0); }
+    bool contains(uint32_t entity) const noexcept       { return entity < slots_.size() && slots_[entity] != not_member_; }
+    size_t size() const noexcept                        { return members_.size(); }
+    bool empty() const noexcept                         { return members_.empty(); }
+    size_t pending() const noexcept                     { return queue_.size(); }
+    inline bool using_stack_buffer() const noexcept     { return members_.using_stack_buffer() && slots_.using_stack_buffer() && queue_.using_stack_buffer(); }
+
+    // accessors, frame stable
+    const SboArray<uint32_t, size_threshold>& members() const noexcept { return members_; }
+    uint32_t operator[](size_t i) const noexcept        { return members_[i]; }
+    const uint32_t* begin() const noexcept              { return members_.begin(); }
+    const uint32_t* end() const noexcept                { return members_.end(); }
+
+//=====================================================================================================================
+// Underlying Data
+//=====================================================================================================================
+
+private:
+    static constexpr uint32_t not_member_ = ~uint32_t(0);
+
+    struct Change
+    {
+        uint32_t entity;
+        bool add;
+    };
+
+    SboArray<uint32_t, size_threshold> members_;    // dense ids
+    SboArray<uint32_t, size_threshold> slots_;      // [entity] -> index into members_, not_member_ otherwise
+    SboArray<Change, 32> queue_;
+    Flags required_;
+    Flags excluded_;
+
+//=====================================================================================================================
+// Implementation
+//=====================================================================================================================
+
+    inline void OnFlagsChanged(uint32_t entity, Flags old_flags, Flags new_flags)
+    {
+        const bool was = matches(old_flags);
+        const bool is = matches(new_flags);
+        if (was != is) { Queue(entity, is); }
+    }
+
+    inline void Queue(uint32_t entity, bool add)        { queue_.push_back({ entity, add }); }
+
+    // an add for a member or a remove for a non member is a no op, so repeated or cancelling changes are fine
+    void Flush()
+    {
+        for (const Change& change : queue_)
+        {
+            if (change.add) { Add(change.entity); }
+            else { Remove(change.entity); }
+        }
+        queue_.clear();
+    }
+
+    inline void Add(uint32_t entity)
+    {
+        // ids tend to come in increasing, growing slots_ geometrically keeps that amortized O(1) per add
+        if (entity >= slots_.size())
+        {
+            if (entity >= slots_.capacity()) { slots_.reserve(std::max(size_t(entity) + 1, slots_.size() * 2)); }
+            slots_.resize(size_t(entity) + 1, not_member_);
+        }
+        if (slots_[entity] != not_member_) { return; }
+        slots_[entity] = uint32_t(members_.size());
+        members_.push_back(entity);
+    }
+
+    inline void Remove(uint32_t entity)
+    {
+        if (!contains(entity)) { return; }
+        const uint32_t slot = slots_[entity];
+        const uint32_t last = members_.back();
+        members_[slot] = last;
+        slots_[last] = slot;
+        members_.pop_back();
+        slots_[entity] = not_member_;
+    }
+
+    void Clear() noexcept
+    {
+        for (uint32_t entity : members_) { slots_[entity] = not_member_; }
+        members_.clear();
+        queue_.clear();
+    }
+};
+
+#endif // SBOQUERYSET_H
@@ -0,0 +1,290 @@
+//=====================================================================================================================
+// MIT License
+//
+// Copyright (c) 2025 Cory Simonich
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//=====================================================================================================================
+
+//=====================================================================================================================
+//
+// Search Index
+//
+//
+// read only lower_bound index over a sorted array, for big sorted arrays that get searched a lot
+//     a binary search over a spilled array misses cache on nearly every level, both layouts here put the
+//     keys a search touches next to each other
+//
+//     SboEytzingerIndex   keys in bfs order (k -> 2k, 2k + 1), the first few levels share cache lines and the
+//                         search prefetches the line 4 levels down, works for any T with operator<
+//     SboSTreeIndex       static b-tree, 16 keys per node (one or two cache lines per level instead of one per
+//                         comparison), a node is searched with SSE compares for int32_t/uint32_t/float keys
+//
+// both keep their own copy of the keys, build() is an O(n) in order walk over the source, rebuild whenever the
+//     source changes
+//
+// lower_bound returns the index into the source array, like std::lower_bound - begin(), size() when every
+//     key is < value
+//
+// Example:
+//
+//      SboArray<u32, 64> sorted_ids = ...;
+//      SboSTreeIndex<u32> index(sorted_ids);
+//      size_t i = index.lower_bound(id);
+//      if (i != sorted_ids.size() && sorted_ids[i] == id) { ... }
+//
+//=====================================================================================================================
+
+
+#ifndef SBOSEARCHINDEX_H
+#define SBOSEARCHINDEX_H
+
+#include "sbo_array.h"
+
+#include <cstdint>      // uint32_t
+
+#if CPP_STANDARD > 2017
+    #include <bit>      // countr_one
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define SBOSEARCH_SSE 1
+#else
+    #define SBOSEARCH_SSE 0
+#endif
+
+//=====================================================================================================================
+// SboEytzingerIndex
+//=====================================================================================================================
+
+template <typename T, size_t size_threshold = 64>
+class SboEytzingerIndex
+{
+public:
+    SboEytzingerIndex()                                 = default;
+    template <typename Sorted>
+    explicit SboEytzingerIndex(const Sorted& sorted)    { build(sorted); }
+
+    // sorted is any contiguous container with data() and size()
+    template <typename Sorted>
+    void build(const Sorted& sorted)                    { Build(sorted.data(), sorted.size()); }
+    void build(const T* sorted, size_t n)               { Build(sorted, n); }
+
+    size_t lower_bound(const T& value) const noexcept   { return LowerBound(value); }
+
+    // query
+    size_t size() const noexcept                        { return keys_.size() - 1; }
+    bool empty() const noexcept                         { return size() == 0; }
+    inline bool using_stack_buffer() const noexcept     { return keys_.using_stack_buffer() && ranks_.using_stack_buffer(); }
+
+private:
+    // 1 based, slot 0 is unused so the children of k are 2k and 2k + 1
+    SboArray<T, size_threshold + 1> keys_ = SboArray<T, size_threshold + 1>(1);
+    SboArray<uint32_t, size_threshold + 1> ranks_ = SboArray<uint32_t, size_threshold + 1>(1);   // slot -> source index
+
+    // 4 levels ahead is 16 slots, one cache line of 4 byte keys
+    static constexpr size_t prefetch_stride_ = (sizeof(T) < 64) ? 64 / sizeof(T) : 1;
+
+    void Build(const T* sorted, size_t n)
+    {
+        keys_ = SboArray<T, size_threshold + 1>(n + 1);
+        ranks_ = SboArray<uint32_t, size_threshold + 1>(n + 1);
+
+        // in order walk of the implicit tree hands out the sorted keys in order, explicit stack, no recursion
+        SboArray<size_t, 64> stack;
+        size_t next = 0;
+        size_t k = 1;
+        while (k <= n || !stack.empty())
+        {
+            for (; k <= n; k *= 2) { stack.push_back(k); }
+            k = stack.back();
+            stack.pop_back();
+            keys_[k] = sorted[next];
+            ranks_[k] = uint32_t(next++);
+            k = 2 * k + 1;
+        }
+    }
+
+    inline size_t LowerBound(const T& value) const noexcept
+    {
+        const size_t n = size();
+        const T* keys = keys_.data();
+        size_t k = 1;
+        while (k <= n)
+        {
+            SBOARRAY_PREFETCH(reinterpret_cast<const char*>(keys) + k * prefetch_stride_ * sizeof(T));
+            k = 2 * k + size_t(keys[k] < value);
+        }
+
+        // every right turn appended a 1, strip the trailing right turns and the last left turn
+        k >>= TrailingOnes(k) + 1;
+        return (k == 0) ? n : ranks_[k];
+    }
+
+    static inline uint32_t TrailingOnes(size_t k) noexcept
+    {
+    #if CPP_STANDARD > 2017
+        return uint32_t(std::countr_one(k));
+    #elif defined(__GNUC__) || defined(__clang__)
+        return uint32_t(__builtin_ctzll(~uint64_t(k)));
+    #else
+        uint32_t n = 0;
+        while (k & 1) { k >>= 1; ++n; }
+        return n;
+    #endif
+    }
+};
+
+//=====================================================================================================================
+// SboSTreeIndex
+//=====================================================================================================================
+
+template <typename T, size_t size_threshold = 64>
+class SboSTreeIndex
+{
+public:
+    SboSTreeIndex()                                     = default;
+    template <typename Sorted>
+    explicit SboSTreeIndex(const Sorted& sorted)        { build(sorted); }
+
+    template <typename Sorted>
+    void build(const Sorted& sorted)                    { Build(sorted.data(), sorted.size()); }
+    void build(const T* sorted, size_t n)               { Build(sorted, n); }
+
+    size_t lower_bound(const T& value) const noexcept   { return LowerBound(value); }
+
+    // query
+    size_t size() const noexcept                        { return count_; }
+    bool empty() const noexcept                         { return count_ == 0; }
+    inline bool using_stack_buffer() const noexcept     { return keys_.using_stack_buffer() && ranks_.using_stack_buffer(); }
+
+private:
+    static constexpr size_t node_keys_ = 16;
+
+    // node k holds keys [k * 16, k * 16 + 16), its 17 children are k * 17 + 1 ... k * 17 + 17
+    //     the last node is padded with copies of the largest key (ranked count_), so padding never wins a search
+    //     that a real key could
+    SboArray<T, size_threshold> keys_;
+    SboArray<uint32_t, size_threshold> ranks_;
+    size_t node_count_ = 0;
+    size_t count_ = 0;
+
+    static constexpr size_t Child(size_t k, size_t i) { return k * (node_keys_ + 1) + i + 1; }
+
+    void Build(const T* sorted, size_t n)
+    {
+        count_ = n;
+        node_count_ = (n + node_keys_ - 1) / node_keys_;
+        keys_ = SboArray<T, size_threshold>(node_count_ * node_keys_);
+        ranks_ = SboArray<uint32_t, size_threshold>(node_count_ * node_keys_);
+
+        // in order walk, a node visits child 0, key 0, child 1, key 1, ... child 16
+        struct Frame { size_t node; size_t i; };
+        SboArray<Frame, 32> stack;
+        size_t next = 0;
+        if (node_count_ != 0) { stack.push_back({ 0, 0 }); }
+        while (!stack.empty())
+        {
+            Frame& top = stack.back();
+            const size_t node = top.node;
+            const size_t i = top.i;
+            if (i > node_keys_) { stack.pop_back(); continue; }
+
+            ++top.i;
+            if (i > 0)
+            {
+                const size_t slot = node * node_keys_ + i - 1;
+                const bool real = next < n;
+                keys_[slot] = real ? sorted[next] : sorted[n - 1];
+                ranks_[slot] = uint32_t(real ? next++ : n);
+            }
+            if (Child(node, i) < node_count_) { stack.push_back({ Child(node, i), 0 }); }
+        }
+    }
+
+    inline size_t LowerBound(const T& value) const noexcept
+    {
+        // the rank is only looked up once at the end, the descent touches nothing but key nodes
+        size_t result = ~size_t(0);
+        size_t k = 0;
+        while (k < node_count_)
+        {
+            const T* node = keys_.data() + k * node_keys_;
+            const size_t i = CountLess(node, value);
+            result = (i < node_keys_) ? k * node_keys_ + i : result;
+            k = Child(k, i);
+        }
+        return (result == ~size_t(0)) ? count_ : ranks_[result];
+    }
+
+    // keys in node that are < value, the node is sorted so this is also the index of the first key >= value
+    static inline size_t CountLess(const T* node, const T& value) noexcept
+    {
+    #if SBOSEARCH_SSE
+        if_constexpr (std::is_same_v<T, float>)
+        {
+            const __m128 x = _mm_set1_ps(value);
+            const int mask = _mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(node + 0), x))
+                           | _mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(node + 4), x)) << 4
+                           | _mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(node + 8), x)) << 8
+                           | _mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(node + 12), x)) << 12;
+            return LowBitCount(uint32_t(mask));
+        }
+        else if_constexpr ((std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t>))
+        {
+            // sse2 only has a signed compare, flipping the sign bit maps unsigned order onto signed order
+            const __m128i bias = _mm_set1_epi32(std::is_same_v<T, uint32_t> ? int32_t(0x80000000u) : 0);
+            const __m128i x = _mm_xor_si128(_mm_set1_epi32(int32_t(value)), bias);
+            const auto less = [&](size_t offset)
+            {
+                const __m128i keys = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(node + offset)), bias);
+                return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(x, keys)));
+            };
+            const int mask = less(0) | less(4) << 4 | less(8) << 8 | less(12) << 12;
+            return LowBitCount(uint32_t(mask));
+        }
+        else
+    #endif
+        {
+            // no early out so the compiler is free to unroll and vectorize it
+            size_t n = 0;
+            for (size_t i = 0; i < node_keys_; ++i) { n += size_t(node[i] < value); }
+            return n;
+        }
+    }
+
+    // the keys are sorted so the compare mask is always a run of low bits, counting it is a single tzcnt/bsf
+    //     instead of a popcount, which baseline x86-64 does not have
+    static inline size_t LowBitCount(uint32_t mask) noexcept
+    {
+    #if CPP_STANDARD > 2017
+        return size_t(std::countr_one(mask));
+    #elif defined(__GNUC__) || defined(__clang__)
+        return size_t(__builtin_ctz(~mask));
+    #else
+        size_t n = 0;
+        for (; mask & 1; mask >>= 1) { ++n; }
+        return n;
+    #endif
+    }
+};
+
+#endif // SBOSEARCHINDEX_H
@@ -0,0 +1,317 @@
+//=====================================================================================================================
+// MIT License
+//
+// Copyright (c) 2025 Cory Simonich
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//=====================================================================================================================
+
+//=====================================================================================================================
+//
+// Spatial Hash Grid
+//
+//
+// uniform 2d grid for broadphase, only the cells that hold something exist
+//     the cell table is one flat open addressing table (linear probing, power of two capacity)
+//     every cell is an SboArray with a small inline capacity, so a typical cell never allocates
+//
+// the table is meant to be rebuilt every frame
+//     clear() is O(1), cell occupancy is an SboMarkerArray so the table just moves to a new generation
+//     a slot that gets claimed again keeps the capacity its cell grew to, after a few frames nothing allocates
+//     rebuild() is a counting sort on the cell keys, a counting pass sizes every cell exactly once and a
+//     scatter pass fills them, no cell grows more than once per frame
+//     the table grows with the number of distinct cells, not entries, 100k entries in 100 cells is a 256 slot table
+//     the table never shrinks by itself (that would throw away the cell capacities), clear(true) or
+//     rebuild(first, last, true) drop it after a scene change
+//
+// entries are points (value + position), for things with extents insert the center and pad the query by the
+//     largest radius, queries test the exact position so results are never outside the query shape
+//
+// Example:
+//
+//      SboSpatialHash<u32> grid(4.0f);                     // 4 unit cells
+//      grid.rebuild(entries.begin(), entries.end());       // entries of { id, x, y }
+//
+//      SboArray<u32, 32> nearby;
+//      grid.query_radius(px, py, 10.0f, nearby);           // appends, caller owns the storage
+//
+//=====================================================================================================================
+
+
+#ifndef SBOSPATIALHASH_H
+#define SBOSPATIALHASH_H
+
+#include "sbo_array.h"
+#include "sbo_marker_array.h"
+
+#include <algorithm>    // max
+#include <cmath>        // floor
+#include <cstdint>      // int32_t, uint64_t
+
+template <typename T, size_t cell_threshold = 8, size_t table_threshold = 32>
+class SboSpatialHash
+{
+
+//=====================================================================================================================
+// Public Api
+//=====================================================================================================================
+public:
+    struct Entry
+    {
+        T value;
+        float x;
+        float y;
+    };
+
+    explicit SboSpatialHash(float cell_size)            { assert(cell_size > 0.0f); inverse_cell_size_ = 1.0f / cell_size; cell_size_ = cell_size; }
+
+    // building
+    void clear(bool shrink_table = false)               { Clear(shrink_table); }
+    void insert(const T& value, float x, float y)       { Insert({ value, x, y }); }
+    void insert(const Entry& entry)                     { Insert(entry); }
+
+    // clear + counting sort of [first, last), *first must be convertible to Entry
+    template <typename ForwardIt>
+    void rebuild(ForwardIt first, ForwardIt last, bool shrink_table = false) { Rebuild(first, last, shrink_table); }
+
+    // queries append into out (any SboArray<T, N>), out is not cleared
+    template <typename Out>
+    void query_radius(float x, float y, float radius, Out& out) const { QueryRadius(x, y, radius, out); }
+    template <typename Out>
+    void query_aabb(float min_x, float min_y, float max_x, float max_y, Out& out) const { QueryAabb(min_x, min_y, max_x, max_y, out); }
+
+    // query
+    size_t size() const noexcept                        { return entry_count_; }
+    size_t cell_count() const noexcept                  { return cell_count_; }
+    size_t table_size() const noexcept                  { return cells_.size(); }
+    float cell_size() const noexcept                    { return cell_size_; }
+    bool empty() const noexcept                         { return entry_count_ == 0; }
+
+//=====================================================================================================================
+// Underlying Data
+//=====================================================================================================================
+
+private:
+    struct Cell
+    {
+        int32_t cx = 0;
+        int32_t cy = 0;
+        uint32_t pending = 0;   // counting pass scratch
+        SboArray<Entry, cell_threshold> items;
+    };
+
+    SboArray<Cell, table_threshold> cells_;
+    SboMarkerArray<table_threshold> used_;
+    SboArray<uint32_t, 256> scratch_slots_; // rebuild scratch, cell slot per entry
+    size_t cell_count_ = 0;
+    size_t entry_count_ = 0;
+    float cell_size_ = 1.0f;
+    float inverse_cell_size_ = 1.0f;
+
+//=====================================================================================================================
+// Implementation
+//=====================================================================================================================
+
+    static size_t NextPowerOfTwo(size_t n) { size_t p = 1; while (p < n) { p <<= 1; } return p; }
+
+    inline int32_t CellCoord(float v) const noexcept { return int32_t(std::floor(v * inverse_cell_size_)); }
+
+    static inline size_t Hash(int32_t cx, int32_t cy) noexcept
+    {
+        uint64_t h = (uint64_t(uint32_t(cx)) << 32) | uint64_t(uint32_t(cy));
+        h *= 0x9E3779B97F4A7C15ull;
+        return size_t(h >> 32);
+    }
+
+    // returns cells_.size() when the cell does not exist
+    inline size_t FindCell(int32_t cx, int32_t cy) const noexcept
+    {
+        if (cells_.empty()) { return 0; }
+        const size_t mask = cells_.size() - 1;
+        for (size_t slot = Hash(cx, cy) & mask; used_.test(slot); slot = (slot + 1) & mask)
+        {
+            const Cell& cell = cells_[slot];
+            if (cell.cx == cx && cell.cy == cy) { return slot; }
+        }
+        return cells_.size();
+    }
+
+    // the table must have room, callers grow first
+    inline size_t FindOrAddCell(int32_t cx, int32_t cy)
+    {
+        const size_t mask = cells_.size() - 1;
+        size_t slot = Hash(cx, cy) & mask;
+        for (; used_.test(slot); slot = (slot + 1) & mask)
+        {
+            const Cell& cell = cells_[slot];
+            if (cell.cx == cx && cell.cy == cy) { return slot; }
+        }
+
+        // a stale slot from an older generation, keep the capacity its items grew to
+        used_.set(slot);
+        Cell& cell = cells_[slot];
+        cell.cx = cx;
+        cell.cy = cy;
+        cell.pending = 0;
+        cell.items.clear();
+        ++cell_count_;
+        return slot;
+    }
+
+    inline void Clear(bool shrink_table)
+    {
+        if (shrink_table) { cells_ = SboArray<Cell, table_threshold>(); used_ = SboMarkerArray<table_threshold>(); }
+        else { used_.clear(); }
+        cell_count_ = 0;
+        entry_count_ = 0;
+    }
+
+    // keeps the table under half full for `cells` live cells
+    //     a regrow moves every live cell, remap (when given) gets old slot -> new slot so slots already handed out
+    //     can be fixed up, returns true when it regrew
+    bool EnsureTable(size_t cells, SboArray<uint32_t, table_threshold>* remap = nullptr)
+    {
+        if (cells * 2 <= cells_.size()) { return false; }
+        const size_t capacity = NextPowerOfTwo(std::max<size_t>(cells * 2, table_threshold));
+
+        SboArray<Cell, table_threshold> old = std::move(cells_);
+        SboMarkerArray<table_threshold> old_used = std::move(used_);
+        cells_ = SboArray<Cell, table_threshold>(capacity);
+        used_.resize(capacity);
+        cell_count_ = 0;
+        if (remap) { *remap = SboArray<uint32_t, table_threshold>(old.size()); }
+
+        for (size_t slot = 0; slot < old.size(); ++slot)
+        {
+            if (!old_used.test(slot)) { continue; }
+            Cell& from = old[slot];
+            const size_t to_slot = FindOrAddCell(from.cx, from.cy);
+            Cell& to = cells_[to_slot];
+            to.items = std::move(from.items);
+            to.pending = from.pending;
+            if (remap) { (*remap)[slot] = uint32_t(to_slot); }
+        }
+        return true;
+    }
+
+    inline void Insert(const Entry& entry)
+    {
+        EnsureTable(cell_count_ + 1);
+        cells_[FindOrAddCell(CellCoord(entry.x), CellCoord(entry.y))].items.push_back(entry);
+        ++entry_count_;
+    }
+
+    template <typename ForwardIt>
+    void Rebuild(ForwardIt first, ForwardIt last, bool shrink_table)
+    {
+        Clear(shrink_table);
+        scratch_slots_.clear();
+
+        size_t n = 0;
+        for (ForwardIt it = first; it != last; ++it) { ++n; }
+        scratch_slots_.reserve(n);
+
+        // counting pass, the table grows as new cells show up, after a regrow the slots handed out so far are
+        //     remapped, that is O(entries so far) but the table doubles so it happens O(log cells) times
+        SboArray<uint32_t, table_threshold> remap;
+        for (ForwardIt it = first; it != last; ++it)
+        {
+            if (EnsureTable(cell_count_ + 1, &remap))
+            {
+                for (uint32_t& slot : scratch_slots_) { slot = remap[slot]; }
+            }
+            const Entry& entry = *it;
+            const uint32_t slot = uint32_t(FindOrAddCell(CellCoord(entry.x), CellCoord(entry.y)));
+            ++cells_[slot].pending;
+            scratch_slots_.push_back(slot);
+        }
+
+        // scatter pass, the first entry of every cell sizes it for the whole frame
+        size_t i = 0;
+        for (ForwardIt it = first; it != last; ++it, ++i)
+        {
+            Cell& cell = cells_[scratch_slots_[i]];
+            if (cell.pending != 0) { cell.items.reserve(cell.items.size() + cell.pending); cell.pending = 0; }
+            cell.items.push_back(*it);
+        }
+        entry_count_ = n;
+    }
+
+    template <typename Out>
+    void QueryRadius(float x, float y, float radius, Out& out) const
+    {
+        const float radius_sq = radius * radius;
+        ForEachCell(x - radius, y - radius, x + radius, y + radius, [&](const Cell& cell)
+        {
+            for (const Entry& e : cell.items)
+            {
+                const float dx = e.x - x;
+                const float dy = e.y - y;
+                if (dx * dx + dy * dy <= radius_sq) { out.push_back(e.value); }
+            }
+        });
+    }
+
+    template <typename Out>
+    void QueryAabb(float min_x, float min_y, float max_x, float max_y, Out& out) const
+    {
+        ForEachCell(min_x, min_y, max_x, max_y, [&](const Cell& cell)
+        {
+            for (const Entry& e : cell.items)
+            {
+                if (e.x >= min_x && e.x <= max_x && e.y >= min_y && e.y <= max_y) { out.push_back(e.value); }
+            }
+        });
+    }
+
+    template <typename F>
+    void ForEachCell(float min_x, float min_y, float max_x, float max_y, F&& fn) const
+    {
+        if (cell_count_ == 0) { return; }
+        const int32_t x0 = CellCoord(min_x);
+        const int32_t y0 = CellCoord(min_y);
+        const int32_t x1 = CellCoord(max_x);
+        const int32_t y1 = CellCoord(max_y);
+
+        // a query wider than the table is cheaper as a walk over the live cells
+        const uint64_t range = uint64_t(int64_t(x1) - x0 + 1) * uint64_t(int64_t(y1) - y0 + 1);
+        if (range > cells_.size())
+        {
+            for (size_t slot = 0; slot < cells_.size(); ++slot)
+            {
+                if (!used_.test(slot)) { continue; }
+                const Cell& cell = cells_[slot];
+                if (cell.cx >= x0 && cell.cx <= x1 && cell.cy >= y0 && cell.cy <= y1) { fn(cell); }
+            }
+            return;
+        }
+
+        for (int32_t cy = y0; cy <= y1; ++cy)
+        {
+            for (int32_t cx = x0; cx <= x1; ++cx)
+            {
+                const size_t slot = FindCell(cx, cy);
+                if (slot != cells_.size()) { fn(cells_[slot]); }
+            }
+        }
+    }
+};
+
+#endif // SBOSPATIALHASH_H
@@ -0,0 +1,286 @@
+//=====================================================================================================================
+// MIT License
+//
+// Copyright (c) 2025 Cory Simonich
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//=====================================================================================================================
+
+//=====================================================================================================================
+//
+// Stable Index Array
+//
+//
+// O(1) erase where indices stay valid, the std::list replacement
+//     erase leaves a hole (tombstone), clears its bit in the occupancy bitmap and pushes the slot on a free list
+//     insert reuses the most recently freed slot before growing
+//     iteration walks the bitmap 64 slots at a time and jumps straight to live slots with a count trailing zeros
+//     compact() squeezes the holes out when they pile up and hands back the old -> new index remap
+//
+// indices are stable until compact(), pointers/references are stable until an insert grows the slot array
+//
+// Example:
+//
+//      SboStableArray<Projectile> projectiles;
+//      uint32_t id = projectiles.insert(p);
+//      projectiles.erase(id);                      // no shifting, every other id still valid
+//      for (Projectile& p : projectiles) { ... }   // skips holes
+//
+//=====================================================================================================================
+
+
+#ifndef SBOSTABLEARRAY_H
+#define SBOSTABLEARRAY_H
+
+#include "sbo_array.h"
+
+#include <algorithm>    // min, max
+#include <cstdint>      // uint32_t, uint64_t
+#include <utility>      // forward, move
+
+#if CPP_STANDARD > 2017
+    #include <bit>      // countr_zero
+#endif
+
+template <typename T, size_t size_threshold = 64>
+class SboStableArray
+{
+
+//=====================================================================================================================
+// Public Api
+//=====================================================================================================================
+public:
+    static constexpr uint32_t invalid_index = ~uint32_t(0);
+
+    // insert/erase
+    uint32_t insert(const T& value)                     { return Emplace(value); }
+    uint32_t insert(T&& value)                          { return Emplace(std::move(value)); }
+    template <typename... Args>
+    uint32_t emplace(Args&&... args)                    { return Emplace(std::forward<Args>(args)...); }
+    void erase(uint32_t index) noexcept                 { Erase(index); }
+    void clear() noexcept                               { Clear(); }
+    void reserve(size_t new_cap)                        { slots_.reserve(new_cap); occupied_.reserve(WordCount(new_cap)); free_.reserve(new_cap); }
+
+    // squeezes the holes out keeping the order of live elements, remap[old] == new index or invalid_index
+    SboArray<uint32_t, size_threshold> compact()        { return Compact(); }
+
+    // query
+    bool empty() const noexcept                         { return count_ == 0; }
+    size_t size() const noexcept                        { return count_; }
+    size_t slot_count() const noexcept                  { return slots_.size(); }
+    size_t hole_count() const noexcept                  { return slots_.size() - count_; }
+    bool contains(uint32_t index) const noexcept        { return index < slots_.size() && IsLive(index); }
+    inline bool using_stack_buffer() const noexcept     { return slots_.using_stack_buffer() && occupied_.using_stack_buffer() && free_.using_stack_buffer(); }
+
+    // accessors
+    T& operator[](uint32_t index) noexcept              { assert(contains(index)); return slots_[index].value; }
+    const T& operator[](uint32_t index) const noexcept  { assert(contains(index)); return slots_[index].value; }
+
+    // fn(uint32_t index, T& value) for every live element in index order
+    template <typename F>
+    void for_each(F&& fn)                               { ForEach(*this, fn); }
+    template <typename F>
+    void for_each(F&& fn) const                         { ForEach(*this, fn); }
+
+    // iterators, forward only, index() gives the stable index of the current element
+    template <typename Owner, typename Ref>
+    class Iterator
+    {
+    public:
+        Iterator(Owner* owner, uint32_t index) : owner_(owner), index_(index) {}
+        Ref operator*() const noexcept                  { return owner_->slots_[index_].value; }
+        auto operator->() const noexcept                { return &owner_->slots_[index_].value; }
+        uint32_t index() const noexcept                 { return index_; }
+        Iterator& operator++() noexcept                 { index_ = owner_->NextLive(index_ + 1); return *this; }
+        bool operator==(const Iterator& rhs) const noexcept { return index_ == rhs.index_; }
+        bool operator!=(const Iterator& rhs) const noexcept { return index_ != rhs.index_; }
+
+    private:
+        Owner* owner_;
+        uint32_t index_;
+    };
+    using iterator = Iterator<SboStableArray, T&>;
+    using const_iterator = Iterator<const SboStableArray, const T&>;
+
+    iterator begin() noexcept                           { return iterator(this, NextLive(0)); }
+    iterator end() noexcept                             { return iterator(this, uint32_t(slots_.size())); }
+    const_iterator begin() const noexcept               { return const_iterator(this, NextLive(0)); }
+    const_iterator end() const noexcept                 { return const_iterator(this, uint32_t(slots_.size())); }
+
+//=====================================================================================================================
+// Underlying Data
+//=====================================================================================================================
+
+private:
+    static constexpr bool plain_old_data_ = std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>;
+
+    // pod slots are plain values, a hole just holds whatever was erased
+    // non pod slots carry their own live flag so SboArray can move and destroy them correctly on its own
+    struct PodSlot
+    {
+        T value;
+    };
+
+    struct ObjectSlot
+    {
+        union { T value; };
+        bool live = false;
+
+        ObjectSlot() noexcept {}
+        ObjectSlot(ObjectSlot&& rhs) noexcept : live(rhs.live) { if (live) { new (&value) T(std::move(rhs.value)); } }
+        ObjectSlot& operator=(ObjectSlot&& rhs) noexcept
+        {
+            if (this != &rhs) { Reset(); live = rhs.live; if (live) { new (&value) T(std::move(rhs.value)); } }
+            return *this;
+        }
+        ~ObjectSlot() { Reset(); }
+
+        void Reset() noexcept { if (live) { value.~T(); live = false; } }
+    };
+
+    using Slot = std::conditional_t<plain_old_data_, PodSlot, ObjectSlot>;
+
+    SboArray<Slot, size_threshold> slots_;
+    SboArray<uint64_t, (size_threshold + 63) / 64> occupied_;   // bit i set == slot i is live
+    SboArray<uint32_t, 8> free_;                                // LIFO, most recently freed slot is still warm, room for every slot
+    size_t count_ = 0;
+
+//=====================================================================================================================
+// Implementation
+//=====================================================================================================================
+
+    static constexpr size_t WordCount(size_t slots) { return (slots + 63) / 64; }
+
+    static inline uint32_t CountTrailingZeros(uint64_t word) noexcept
+    {
+        assert(word != 0);
+    #if CPP_STANDARD > 2017
+        return uint32_t(std::countr_zero(word));
+    #elif defined(__GNUC__) || defined(__clang__)
+        return uint32_t(__builtin_ctzll(word));
+    #else
+        uint32_t n = 0;
+        while ((word & 1) == 0) { word >>= 1; ++n; }
+        return n;
+    #endif
+    }
+
+    inline bool IsLive(uint32_t index) const noexcept { return (occupied_[index >> 6] >> (index & 63)) & 1; }
+    inline void SetLive(uint32_t index) noexcept { occupied_[index >> 6] |= (uint64_t(1) << (index & 63)); }
+    inline void ClearLive(uint32_t index) noexcept { occupied_[index >> 6] &= ~(uint64_t(1) << (index & 63)); }
+
+    // first live index >= from, or slots_.size()
+    inline uint32_t NextLive(uint32_t from) const noexcept
+    {
+        const uint32_t end = uint32_t(slots_.size());
+        if (from >= end) { return end; }
+
+        size_t w = from >> 6;
+        uint64_t word = occupied_[w] & (~uint64_t(0) << (from & 63));
+        while (word == 0)
+        {
+            if (++w >= occupied_.size()) { return end; }
+            word = occupied_[w];
+        }
+        return uint32_t(w * 64) + CountTrailingZeros(word);
+    }
+
+    template <typename Self, typename F>
+    static void ForEach(Self& self, F&& fn)
+    {
+        const size_t words = self.occupied_.size();
+        for (size_t w = 0; w < words; ++w)
+        {
+            for (uint64_t word = self.occupied_[w]; word != 0; word &= word - 1)
+            {
+                const uint32_t index = uint32_t(w * 64) + CountTrailingZeros(word);
+                fn(index, self.slots_[index].value);
+            }
+        }
+    }
+
+    template <typename... Args>
+    uint32_t Emplace(Args&&... args)
+    {
+        uint32_t index;
+        if (!free_.empty())
+        {
+            index = free_.back();
+            free_.pop_back();
+        }
+        else
+        {
+            // free_ always has room for every slot, so erase (noexcept) never has to grow it
+            index = uint32_t(slots_.size());
+            if (free_.capacity() <= index) { free_.reserve(std::max(size_t(index) + 1, free_.capacity() * 2)); }
+            if (WordCount(size_t(index) + 1) > occupied_.size()) { occupied_.push_back(0); }
+            slots_.emplace_back();
+        }
+
+        Slot& slot = slots_[index];
+        if_constexpr (plain_old_data_) { slot.value = T(std::forward<Args>(args)...); }
+        else { new (&slot.value) T(std::forward<Args>(args)...); slot.live = true; }
+
+        SetLive(index);
+        ++count_;
+        return index;
+    }
+
+    inline void Erase(uint32_t index) noexcept
+    {
+        assert(contains(index));
+        if_constexpr (!plain_old_data_) { slots_[index].Reset(); }
+        ClearLive(index);
+        free_.push_back(index);
+        --count_;
+    }
+
+    inline void Clear() noexcept
+    {
+        slots_.clear();
+        occupied_.clear();
+        free_.clear();
+        count_ = 0;
+    }
+
+    SboArray<uint32_t, size_threshold> Compact()
+    {
+        SboArray<uint32_t, size_threshold> remap(slots_.size(), invalid_index);
+
+        uint32_t write = 0;
+        ForEach(*this, [&](uint32_t index, T&)
+        {
+            if (index != write) { slots_[write] = std::move(slots_[index]); }
+            remap[index] = write++;
+        });
+
+        slots_.erase(slots_.begin() + write, slots_.end());
+        occupied_.clear();
+        for (size_t w = 0; w < WordCount(write); ++w)
+        {
+            const size_t live_bits = std::min<size_t>(64, write - w * 64);
+            occupied_.push_back((live_bits == 64) ? ~uint64_t(0) : ((uint64_t(1) << live_bits) - 1));
+        }
+        free_.clear();
+        return remap;
+    }
+};
+
+#endif // SBOSTABLEARRAY_H
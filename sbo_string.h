@@ -0,0 +1,274 @@
+//=====================================================================================================================
+// MIT License
+//
+// Copyright (c) 2025 Cory Simonich
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//=====================================================================================================================
+
+//=====================================================================================================================
+//
+// SboString
+//
+//
+// string builder for log lines, ui labels and debug names, an SboArray<char> underneath
+//     labels shorter than size_threshold never allocate
+//     numbers are written with std::to_chars straight into the tail capacity, no temporaries, no locale
+//     appendf is vsnprintf straight into the tail capacity, it only formats twice when it has to grow
+//     both only grow when the result does not fit the free tail, never for a worst case
+//
+// the buffer always holds a terminating '\0' after the last character, so c_str() is free, the '\0' is not
+//     counted by size() but it does use one byte of the inline buffer
+//
+// Example:
+//
+//      SboString<64> label;
+//      label.append("hp ").append_int(entity.hp).append('/').append_int(entity.max_hp);
+//      label.appendf(" (%.1f%%)", percent);
+//      DrawText(label.c_str());
+//
+//=====================================================================================================================
+
+
+#ifndef SBOSTRING_H
+#define SBOSTRING_H
+
+#include "sbo_array.h"
+
+#include <algorithm>    // max
+#include <charconv>     // to_chars
+#include <cstdarg>      // va_list
+#include <cstdio>       // vsnprintf
+#include <functional>   // less
+#include <limits>       // numeric_limits
+#include <string_view>  // string_view
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define SBOSTRING_PRINTF_FORMAT(fmt_index, args_index) __attribute__((format(printf, fmt_index, args_index)))
+#else
+    #define SBOSTRING_PRINTF_FORMAT(fmt_index, args_index)
+#endif
+
+template <size_t size_threshold = 64>
+class SboString
+{
+
+//=====================================================================================================================
+// Public Api
+//=====================================================================================================================
+public:
+    SboString()                                         { Terminate(0); }
+    SboString(std::string_view text)                    { Terminate(0); Append(text); }
+    SboString(const char* text)                         { Terminate(0); Append(std::string_view(text)); }
+
+    // append, all of them return *this so calls chain
+    SboString& append(std::string_view text)            { Append(text); return *this; }
+    SboString& append(const char* text)                 { Append(std::string_view(text)); return *this; }
+    SboString& append(char c)                           { AppendChar(c); return *this; }
+    SboString& append(size_t count, char c)             { AppendFill(count, c); return *this; }
+    template <size_t N>
+    SboString& append(const SboString<N>& other)        { Append(other.view()); return *this; }
+    SboString& operator+=(std::string_view text)        { return append(text); }
+    SboString& operator+=(const char* text)             { return append(text); }
+    SboString& operator+=(char c)                       { return append(c); }
+
+    // numbers, base only applies to integers
+    template <typename Int>
+    SboString& append_int(Int value, int base = 10)     { AppendInt(value, base); return *this; }
+
+    // shortest round trip representation, or fixed with `precision` digits after the point when precision >= 0
+    template <typename Float>
+    SboString& append_float(Float value, int precision = -1) { AppendFloat(value, precision); return *this; }
+
+    // printf style, formatted directly into the reserved tail, so no argument may point into this string
+    SboString& appendf(const char* fmt, ...) SBOSTRING_PRINTF_FORMAT(2, 3)
+    {
+        va_list args;
+        va_start(args, fmt);
+        AppendFormat(fmt, args);
+        va_end(args);
+        return *this;
+    }
+    SboString& vappendf(const char* fmt, va_list args)  { AppendFormat(fmt, args); return *this; }
+
+    void clear() noexcept                               { Terminate(0); }
+    void reserve(size_t new_cap)                        { chars_.reserve(new_cap + 1); }
+    void pop_back() noexcept                            { assert(!empty()); Terminate(size() - 1); }
+    void truncate(size_t new_size) noexcept             { assert(new_size <= size()); Terminate(new_size); }
+
+    // query
+    bool empty() const noexcept                         { return size() == 0; }
+    size_t size() const noexcept                        { return chars_.size() - 1; }
+    size_t length() const noexcept                      { return size(); }
+    size_t capacity() const noexcept                    { return chars_.capacity() - 1; }
+    inline bool using_stack_buffer() const noexcept     { return chars_.using_stack_buffer(); }
+
+    // accessors, the view is zero copy and is invalidated by the next append that grows the buffer
+    std::string_view view() const noexcept              { return std::string_view(chars_.data(), size()); }
+    operator std::string_view() const noexcept          { return view(); }
+    const char* c_str() const noexcept                  { return chars_.data(); }
+    const char* data() const noexcept                   { return chars_.data(); }
+    char* data() noexcept                               { return chars_.data(); }
+    char& operator[](size_t i) noexcept                 { assert(i < size()); return chars_[i]; }
+    const char& operator[](size_t i) const noexcept     { assert(i < size()); return chars_[i]; }
+
+    // iterators
+    using value_type = char;
+    using iterator = char*;
+    using const_iterator = const char*;
+
+    iterator begin() noexcept                           { return chars_.data(); }
+    iterator end() noexcept                             { return chars_.data() + size(); }
+    const_iterator begin() const noexcept               { return chars_.data(); }
+    const_iterator end() const noexcept                 { return chars_.data() + size(); }
+
+    friend bool operator==(const SboString& lhs, std::string_view rhs) noexcept { return lhs.view() == rhs; }
+    friend bool operator!=(const SboString& lhs, std::string_view rhs) noexcept { return lhs.view() != rhs; }
+
+//=====================================================================================================================
+// Underlying Data
+//=====================================================================================================================
+
+private:
+    // content + '\0', size() == chars_.size() - 1
+    SboArray<char, size_threshold> chars_;
+
+//=====================================================================================================================
+// Implementation
+//=====================================================================================================================
+
+    // sets the length and rewrites the terminator
+    inline void Terminate(size_t new_size)
+    {
+        chars_.resize_and_overwrite(new_size + 1, [new_size](char* p, size_t) { p[new_size] = '\0'; return new_size + 1; });
+    }
+
+    // op(char* tail, size_t room) writes at most room chars and returns how many, or no_fit to write nothing
+    static constexpr size_t no_fit = ~size_t(0);
+
+    // makes sure at least `min_room` chars are free after the content then runs op on the tail, false on no_fit
+    template <typename Op>
+    inline bool AppendWith(size_t min_room, Op op)
+    {
+        const size_t old_size = size();
+        bool fits = true;
+        chars_.resize_and_overwrite(GrowthFor(old_size + min_room + 1), [&](char* p, size_t cap)
+        {
+            size_t written = op(p + old_size, cap - old_size - 1);
+            if (written == no_fit) { fits = false; written = 0; }
+            p[old_size + written] = '\0';
+            return old_size + written + 1;
+        });
+        return fits;
+    }
+
+    // doubles so a long chain of small appends does not reallocate on every call
+    inline size_t GrowthFor(size_t n) const noexcept
+    {
+        const size_t cap = chars_.capacity();
+        return (n <= cap) ? cap : std::max(n, cap * 2);
+    }
+
+    // text may be a view of this string (s.append(s)), growing frees the block it points into, so it is read
+    //     back at the same offset in the new block instead, the content before the tail moves over unchanged
+    inline void Append(std::string_view text)
+    {
+        const char* base = chars_.data();
+        const std::less<const char*> before;
+        const bool inside = !text.empty() && !before(text.data(), base) && before(text.data(), base + chars_.size());
+        const size_t offset = inside ? size_t(text.data() - base) : 0;
+        const size_t old_size = size();
+        AppendWith(text.size(), [&](char* tail, size_t)
+        {
+            const char* from = inside ? tail - old_size + offset : text.data();
+            std::memcpy(tail, from, text.size());
+            return text.size();
+        });
+    }
+
+    inline void AppendChar(char c)
+    {
+        AppendWith(1, [c](char* tail, size_t) { *tail = c; return size_t(1); });
+    }
+
+    inline void AppendFill(size_t count, char c)
+    {
+        AppendWith(count, [&](char* tail, size_t) { std::memset(tail, c, count); return count; });
+    }
+
+    // numbers try the room that is already free first, so a short label never grows for a worst case it
+    //     does not hit, then again with room for the worst case
+    template <typename Int>
+    inline void AppendInt(Int value, int base)
+    {
+        static_assert(std::is_integral_v<Int>, "SboString::append_int needs an integer type");
+        const auto op = [&](char* tail, size_t room)
+        {
+            const std::to_chars_result r = std::to_chars(tail, tail + room, value, base);
+            return (r.ec == std::errc()) ? size_t(r.ptr - tail) : no_fit;
+        };
+
+        // base 2 is the worst case, one char per bit plus the sign
+        if (!AppendWith(0, op)) { AppendWith(sizeof(Int) * 8 + 1, op); }
+    }
+
+    template <typename Float>
+    inline void AppendFloat(Float value, int precision)
+    {
+        static_assert(std::is_floating_point_v<Float>, "SboString::append_float needs a floating point type");
+        const auto op = [&](char* tail, size_t room)
+        {
+            const std::to_chars_result r = (precision < 0)
+                ? std::to_chars(tail, tail + room, value)
+                : std::to_chars(tail, tail + room, value, std::chars_format::fixed, precision);
+            return (r.ec == std::errc()) ? size_t(r.ptr - tail) : no_fit;
+        };
+
+        // 32 covers any shortest round trip form, fixed notation of a huge value needs up to ~310 integer digits
+        const size_t digits = (precision > 0) ? size_t(precision) : 0;
+        if (AppendWith(0, op)) { return; }
+        if (AppendWith(32 + digits, op)) { return; }
+        AppendWith(std::numeric_limits<Float>::max_exponent10 + 32 + digits, op);
+    }
+
+    inline void AppendFormat(const char* fmt, va_list args)
+    {
+        // vsnprintf consumes the va_list, keep a copy in case the first attempt does not fit
+        va_list retry;
+        va_copy(retry, args);
+
+        // room + 1 because the terminator slot is free to write into
+        int needed = 0;
+        const bool fits = AppendWith(0, [&](char* tail, size_t room)
+        {
+            needed = std::vsnprintf(tail, room + 1, fmt, args);
+            return (needed >= 0 && size_t(needed) <= room) ? size_t(needed) : no_fit;
+        });
+
+        // too long, but now the exact size is known
+        if (!fits && needed > 0)
+        {
+            AppendWith(size_t(needed), [&](char* tail, size_t) { std::vsnprintf(tail, size_t(needed) + 1, fmt, retry); return size_t(needed); });
+        }
+        va_end(retry);
+    }
+};
+
+#endif // SBOSTRING_H